@@ -0,0 +1,69 @@
+"""
+Creates the large clock digits(0-9 and ':'), drawn as seven segment digits
+
+The output is in the format of the GFX fonts: every glyph is stored as its columns, each column is split into pages of
+8 rows, the top page first, the top row of each page in the MSB
+"""
+
+HEIGHT = 32
+DIGIT_WIDTH = 14
+COLON_WIDTH = 3
+
+SEGMENTS = {'0': 'abcdef', '1': 'bc', '2': 'abged', '3': 'abgcd', '4': 'fgbc', '5': 'afgcd', '6': 'afgedc',
+            '7': 'abc', '8': 'abcdefg', '9': 'abcdfg'}
+
+
+def digit_lit(digit, x, y):
+    segments = SEGMENTS[digit]
+
+    def horizontal(center):
+        dy = abs(y - center)
+        return dy <= 1 and 2 + dy <= x <= DIGIT_WIDTH - 3 - dy
+
+    def vertical(center, first, last):
+        dx = abs(x - center)
+        return dx <= 1 and first + dx <= y <= last - dx
+
+    lit = {
+        'a': horizontal(1),
+        'g': horizontal(15),
+        'd': horizontal(29),
+        'f': vertical(1, 2, 14),
+        'b': vertical(DIGIT_WIDTH - 2, 2, 14),
+        'e': vertical(1, 16, 28),
+        'c': vertical(DIGIT_WIDTH - 2, 16, 28),
+    }
+    return any(lit[s] for s in segments)
+
+
+def colon_lit(x, y):
+    return 8 <= y <= 10 or 20 <= y <= 22
+
+
+def columns(width, lit):
+    ret = []
+    for x in range(width):
+        for page in range(HEIGHT // 8):
+            val = 0
+            for row in range(8):
+                val = val | (lit(x, page * 8 + row) << (7 - row))
+            ret.append(val)
+    return ret
+
+
+def main():
+    glyphs = [(d, columns(DIGIT_WIDTH, lambda x, y, d=d: digit_lit(d, x, y))) for d in "0123456789"]
+    glyphs.append((':', columns(COLON_WIDTH, colon_lit)))
+
+    ret = str()
+    for char, data in glyphs:
+        ret += "    // '{}'\n".format(char)
+        for i in range(0, len(data), 8):
+            ret += "    " + ", ".join("0x{:02x}".format(val) for val in data[i:i + 8]) + ",\n"
+
+    with open("out.txt", "w") as f:
+        f.write(ret)
+
+
+if __name__ == '__main__':
+    main()
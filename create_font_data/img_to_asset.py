@@ -0,0 +1,149 @@
+"""
+Converts the images in assets/ to compressed images for GFX::draw_image(), written to src/display/assets.h
+
+The image is split into bands of 8 rows, the top band first. Each band is stored as its columns, one byte per column
+with the top row in the MSB, which is the layout of a page in the display RAM. Every band is compressed on its own, so
+a strip of the canvas only decodes the bands it shows. The compression is a run length encoding: a control byte c
+below 0x80 is followed by c + 1 literal bytes, otherwise the next byte is repeated c - 0x80 + 3 times. See
+lib/SSD1306/SSD1306/image.h for the decoder.
+
+Images are plain PBM (P1), which can be drawn and diffed as text, 1 is a lit pixel. Other formats are read with PIL,
+where dark pixels are lit, like the fonts.
+
+Usage:
+ - python img_to_asset.py: convert all images in assets/
+ - as a PlatformIO extra script(see platformio.ini): the same before each build, if an image is newer than the header
+"""
+
+import os
+import sys
+
+ASSETS_DIR = "assets"
+OUT_FILE = os.path.join("src", "display", "assets.h")
+EXTENSIONS = (".pbm", ".png", ".bmp")
+
+
+def read_pbm(path):
+    """Pixels of a plain PBM image, as rows of bools"""
+    with open(path) as f:
+        tokens = []
+        for line in f:
+            tokens.extend(line.split("#", 1)[0].split())
+    if tokens[0] != "P1":
+        raise ValueError(f"{path}: only plain PBM(P1) is supported")
+    w, h = int(tokens[1]), int(tokens[2])
+    # the pixels may be written without spaces
+    bits = "".join(tokens[3:])
+    if len(bits) != w * h:
+        raise ValueError(f"{path}: expected {w * h} pixels, got {len(bits)}")
+    return [[bits[y * w + x] == "1" for x in range(w)] for y in range(h)]
+
+
+def read_image(path):
+    """Pixels of the image at @p path, as rows of bools"""
+    if path.endswith(".pbm"):
+        return read_pbm(path)
+    from PIL import Image
+    im = Image.open(path).convert("L")
+    (w, h) = im.size
+    return [[im.getpixel((x, y)) < 128 for x in range(w)] for y in range(h)]
+
+
+def bands(pixels):
+    """The bands of 8 rows, each as its columns with the top row in the MSB"""
+    h, w = len(pixels), len(pixels[0])
+    ret = []
+    for y0 in range(0, h, 8):
+        columns = []
+        for x in range(w):
+            val = 0
+            for row in range(8):
+                if y0 + row < h and pixels[y0 + row][x]:
+                    val = val | (1 << (7 - row))
+            columns.append(val)
+        ret.append(columns)
+    return ret
+
+
+def compress(data):
+    """Run length encoding of @p data, runs of 3 or more bytes are repeated, the rest is copied"""
+    out = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 130 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out += [0x80 + run - 3, data[i]]
+            i += run
+            continue
+
+        # literals up to the next run of 3
+        end = i + 1
+        while end < len(data) and end - i < 128 and not (end + 2 < len(data) and data[end] == data[end + 1] ==
+                                                           data[end + 2]):
+            end += 1
+        out += [end - i - 1] + data[i:end]
+        i = end
+    return out
+
+
+def to_code(name, pixels):
+    """C++ definition of the image @p name"""
+    w, h = len(pixels[0]), len(pixels)
+    if w > 128 or h > 64:
+        raise ValueError(f"{name}: {w}x{h} is larger than the display")
+
+    offsets = [0]
+    data = []
+    for band in bands(pixels):
+        data += compress(band)
+        offsets.append(len(data))
+
+    ret = f"  /// {w}x{h}, {len(data)} bytes instead of {w * len(offsets[1:])}\n"
+    ret += f"  inline constexpr uint16_t {name}_bands[] = {{ {', '.join(str(o) for o in offsets)} }};\n"
+    ret += f"  inline constexpr uint8_t {name}_data[] = {{\n"
+    for i in range(0, len(data), 16):
+        ret += "    " + ", ".join("0x{:02x}".format(val) for val in data[i:i + 16]) + ",\n"
+    ret += "  };\n"
+    ret += f"  inline constexpr images::Image_t {name}{{ {w}, {h}, {name}_bands, {name}_data }};\n"
+    ret += f"  static_assert(images::valid({name}));\n"
+    return ret
+
+
+def convert(paths, out_file):
+    code = "#pragma once\n\n"
+    code += "/**\n * @file assets.h\n * @brief Images of the screens, see GFX::draw_image()\n"
+    code += " * @details Generated by create_font_data/img_to_asset.py from the images in assets/, don't edit.\n */\n\n"
+    code += "#include \"SSD1306/image.h\"\n\nnamespace assets {\n\n"
+    code += "\n".join(to_code(os.path.splitext(os.path.basename(p))[0], read_image(p)) for p in sorted(paths))
+    code += "\n}  // namespace assets\n"
+    with open(out_file, "w") as f:
+        f.write(code)
+
+
+def find_assets(project_dir):
+    assets = os.path.join(project_dir, ASSETS_DIR)
+    return [os.path.join(assets, f) for f in sorted(os.listdir(assets)) if f.endswith(EXTENSIONS)]
+
+
+def main():
+    project_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    convert(find_assets(project_dir), os.path.join(project_dir, OUT_FILE))
+
+
+def build_assets(project_dir):
+    """Convert the images before the build, if one is newer than the header"""
+    paths = find_assets(project_dir)
+    out_file = os.path.join(project_dir, OUT_FILE)
+    if os.path.exists(out_file) and all(os.path.getmtime(p) <= os.path.getmtime(out_file) for p in paths):
+        return
+    print("img_to_asset.py: converting " + ", ".join(os.path.basename(p) for p in paths))
+    convert(paths, out_file)
+
+
+if __name__ == '__main__':
+    main()
+elif "SCons" in sys.modules:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    build_assets(env.subst("$PROJECT_DIR"))  # noqa: F821
@@ -1,36 +1,42 @@
 from PIL import Image
 import numpy as np
 
+# width of one glyph in pixels, the height has to be 8 (one page of the display)
+GLYPH_WIDTH = 8
+FIRST_CHAR = 32
+
+
 def main():
 
     im = Image.open("font_example.bmp")
     (w, h) = im.size
     print(f"w: {w}, h: {h}")
+    if h != 8:
+        raise ValueError("the font has to be 8 pixels high")
     arr = np.array(im)
-    pixels = []
-    for col in range(h):
-        for row in range(w):
-            pixels.append(arr[col][row])
-
-    print(len(pixels))
 
-    combined = []
-    for i in range(0, len(pixels), 8):
-        val = 0
-        for j in range(0, 8):
-            is_lit = not bool(pixels[i+j])
-            val = val | ( is_lit << (7-j))
-        combined.append(val)
+    # the display is written one column of 8 pixels at a time,
+    # so store every glyph as its columns, with the top row in the MSB
+    glyphs = []
+    for x0 in range(0, w, GLYPH_WIDTH):
+        columns = []
+        for col in range(x0, x0 + GLYPH_WIDTH):
+            val = 0
+            for row in range(0, 8):
+                is_lit = not bool(arr[row][col])
+                val = val | (is_lit << (7 - row))
+            columns.append(val)
+        glyphs.append(columns)
+
+    print(len(glyphs))
 
     ret = str()
-
-    ret += "{"
-    for val in combined:
-        ret += "0x{:02x}".format(val)
-        ret += ", "
-
-    ret = ret[:-2]
-    ret += "};"
+    for i, columns in enumerate(glyphs):
+        char = chr(FIRST_CHAR + i)
+        if char in "\\'":
+            char = "\\" + char
+        ret += "    " + ", ".join("0x{:02x}".format(val) for val in columns)
+        ret += ",  // '{}'\n".format(char)
 
     with open("out.txt", "w") as f:
         f.write(ret)
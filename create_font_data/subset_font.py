@@ -0,0 +1,95 @@
+"""
+Generates the glyphs of font1 outside of ASCII, for the characters which are used in the sources, written to
+lib/SSD1306/SSD1306/font1_extra.h
+
+font1_extra.pbm holds the extra glyphs which are drawn, 8x8 each, in the order of the characters in font1_extra.txt.
+All string literals in src/ and lib/ are searched for characters outside of ASCII, and only their glyphs are written,
+sorted by codepoint, so the flash only holds the glyphs which are used. fonts::font1 appends them to the ASCII glyphs,
+and finds them by a binary search of their codepoints.
+
+Usage: python subset_font.py, after text with a new character was added
+"""
+
+import os
+import re
+
+from img_to_asset import read_pbm
+
+GLYPH_WIDTH = 8
+SHEET = "font1_extra.pbm"
+CHARACTERS = "font1_extra.txt"
+SOURCES = ("src", "lib")
+OUT_FILE = os.path.join("lib", "SSD1306", "SSD1306", "font1_extra.h")
+
+# string literals, without raw strings and with escaped quotes
+STRING_LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+
+
+def read_sheet(directory):
+    """The glyphs of the sheet by character, each as its columns with the top row in the MSB"""
+    pixels = read_pbm(os.path.join(directory, SHEET))
+    with open(os.path.join(directory, CHARACTERS), encoding="utf-8") as f:
+        characters = f.read().strip()
+    if len(pixels) != 8 or len(pixels[0]) != GLYPH_WIDTH * len(characters):
+        raise ValueError(f"{SHEET} has to be 8 rows high, with {len(characters)} glyphs of {GLYPH_WIDTH} columns")
+
+    glyphs = {}
+    for i, char in enumerate(characters):
+        columns = []
+        for x in range(i * GLYPH_WIDTH, (i + 1) * GLYPH_WIDTH):
+            columns.append(sum(1 << (7 - row) for row in range(8) if pixels[row][x]))
+        glyphs[char] = columns
+    return glyphs
+
+
+def used_characters(project_dir):
+    """Characters outside of ASCII in the string literals of the sources"""
+    ret = set()
+    for source in SOURCES:
+        for root, _, files in os.walk(os.path.join(project_dir, source)):
+            for name in files:
+                if not name.endswith((".h", ".cpp", ".c")) or name == os.path.basename(OUT_FILE):
+                    continue
+                with open(os.path.join(root, name), encoding="utf-8", errors="replace") as f:
+                    for literal in STRING_LITERAL.findall(f.read()):
+                        ret.update(c for c in literal if ord(c) > 0x7F and c != "�")
+    return ret
+
+
+def to_code(glyphs, used):
+    missing = sorted(used - glyphs.keys())
+    if missing:
+        raise ValueError(f"no glyphs for {''.join(missing)} in {SHEET}")
+    chars = sorted(used)
+    if any(ord(c) > 0xFFFF for c in chars):
+        raise ValueError("codepoints are 16 bits")
+
+    code = "#pragma once\n\n"
+    code += "/**\n * @file font1_extra.h\n"
+    code += " * @brief Glyphs of font1 outside of ASCII, only the ones used in the sources\n"
+    code += " * @details Generated by create_font_data/subset_font.py, don't edit.\n */\n\n"
+    code += "#include <array>\n#include <cstdint>\n\nnamespace fonts {\n\n"
+    code += "  /// Codepoints of the extra glyphs, sorted\n"
+    code += f"  inline constexpr std::array<uint16_t, {len(chars)}> font1_extra_codepoints{{\n"
+    code += "".join(f"    0x{ord(c):04x},  // '{c}'\n" for c in chars)
+    code += "  };\n\n"
+    code += "  /// Columns of the extra glyphs, in the order of their codepoints\n"
+    code += f"  inline constexpr std::array<uint8_t, {len(chars) * GLYPH_WIDTH}> font1_extra_data{{\n"
+    for c in chars:
+        code += "    " + ", ".join("0x{:02x}".format(val) for val in glyphs[c]) + f",  // '{c}'\n"
+    code += "  };\n\n}  // namespace fonts\n"
+    return code
+
+
+def main():
+    directory = os.path.dirname(os.path.abspath(__file__))
+    project_dir = os.path.join(directory, "..")
+    used = used_characters(project_dir)
+    code = to_code(read_sheet(directory), used)
+    with open(os.path.join(project_dir, OUT_FILE), "w", encoding="utf-8") as f:
+        f.write(code)
+    print(f"{len(used)} extra glyphs: {''.join(sorted(used))}")
+
+
+if __name__ == '__main__':
+    main()
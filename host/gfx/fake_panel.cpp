@@ -0,0 +1,196 @@
+/**
+ * @file fake_panel.cpp
+ * @brief Display controllers for the host, which receive the I2C writes of the real drivers
+ *
+ */
+
+#include "display_driver.h"
+#include "host_display.h"
+
+#include <algorithm>
+
+namespace host {
+
+  Panel panel;
+  Panel status_panel;
+
+  namespace {
+#ifdef DISPLAY_SH1106
+    constexpr bool sh1106 = true;
+#else
+    constexpr bool sh1106 = false;
+#endif
+
+    /// Arguments following command @p c
+    constexpr int arguments(uint8_t c) {
+      switch (c) {
+        case 0x20:  // addressing mode
+        case 0x81:  // contrast
+        case 0x8D:  // charge pump
+        case 0xA8:  // mux ratio
+        case 0xAD:  // DC-DC of the SH1106
+        case 0xD3:  // display offset
+        case 0xD5:  // clock
+        case 0xD9:  // pre-charge
+        case 0xDA:  // COM pins
+        case 0xDB:  // VCOMH
+          return 1;
+        case 0x21:  // column window
+        case 0x22:  // page window
+        case 0xA3:  // vertical scroll area
+          return 2;
+        case 0x29:  // vertical and horizontal scroll
+        case 0x2A:
+          return 5;
+        case 0x26:  // horizontal scroll
+        case 0x27:
+          return 6;
+        default:
+          return 0;
+      }
+    }
+
+    /// The SH1106 has only page addressing and no scrolling, and its DC-DC replaces the charge pump
+    constexpr bool supported(uint8_t c) {
+      if (sh1106) {
+        return (c < 0x20 || c > 0x2F) && c != 0x8D && c != 0xA3;
+      }
+      return c != 0xAD;
+    }
+  }  // namespace
+
+  void Panel::write(uint8_t control, const uint8_t* bytes, std::size_t len) {
+    bool has_data = false;
+    std::size_t i = 0;
+    while (i < len) {
+      // Co set: one byte follows, and then the next control byte. Otherwise all remaining bytes follow. D/C# set: data
+      const bool one = control & 0x80;
+      const bool is_data = control & 0x40;
+      const std::size_t end = one ? i + 1 : len;
+      for (; i < end; ++i) {
+        if (is_data) {
+          data(bytes[i]);
+          has_data = true;
+        } else {
+          command(bytes[i]);
+        }
+      }
+      if (i < len) {
+        control = bytes[i++];
+      }
+    }
+    transfers += has_data;
+  }
+
+  void Panel::command(uint8_t byte) {
+    cmd[cmd_len++] = byte;
+    const uint8_t c = cmd[0];
+    if (cmd_len <= arguments(c)) {
+      return;
+    }
+    cmd_len = 0;
+    commands += 1 + arguments(c);
+    if (not supported(c)) {
+      ++errors;
+      return;
+    }
+
+    if (c <= 0x0F) {
+      column = (column & 0xF0) | (c & 0x0F);
+    } else if (c <= 0x1F) {
+      column = (column & 0x0F) | ((c & 0x0F) << 4);
+    } else if (c == 0x20) {
+      mode = cmd[1] & 0x3;
+    } else if (c == 0x21) {
+      first_column = column = cmd[1] & 0x7F;
+      last_column = cmd[2] & 0x7F;
+    } else if (c == 0x22) {
+      first_page = page = cmd[1] & 0x7;
+      last_page = cmd[2] & 0x7;
+    } else if (c >= 0x40 && c <= 0x7F) {
+      start_line = c & 0x3F;
+    } else if (c >= 0xB0 && c <= 0xB7) {
+      page = c & 0x7;
+    }
+    // the rest configures the panel, and the scroll isn't modelled, the picture stays
+  }
+
+  void Panel::data(uint8_t byte) {
+    if (column < ram_columns) {
+      ram[column][page] = byte;
+    }
+    ++bytes_sent;
+
+    if (mode == 0) {
+      // horizontal: along the page, then on to the next one
+      if (column >= last_column) {
+        column = first_column;
+        page = page >= last_page ? first_page : page + 1;
+      } else {
+        ++column;
+      }
+    } else if (mode == 1) {
+      // vertical: down the column, then on to the next one
+      if (page >= last_page) {
+        page = first_page;
+        column = column >= last_column ? first_column : column + 1;
+      } else {
+        ++page;
+      }
+    } else if (sh1106) {
+      // page: the SH1106 stops at its last column
+      column = std::min(column + 1, ram_columns - 1);
+    } else {
+      // page: the SSD1306 wraps around in the column window
+      column = column >= last_column ? first_column : column + 1;
+    }
+  }
+
+  image_t Panel::image() const {
+    image_t img{};
+    for (int x = 0; x < ::Display::width; ++x) {
+      for (int y = 0; y < ::Display::height; ++y) {
+        // the bottom row of the panel shows the start line, and row y of the canvas is in page pages - 1 - y / 8, the
+        // top row in the MSB. A start line moves the picture down, wrapping around the 64 rows of the RAM
+        const int row = (::Display::height - 1 - y + start_line) % 64;
+        img[x][y] = ram[x + ::Display::column_offset][row / 8] & (1 << (row % 8));
+      }
+    }
+    return img;
+  }
+
+}  // namespace host
+
+
+/// Display at the shifted I2C @p address, nullptr if no device answers
+static host::Panel* panel_at(uint16_t address) {
+  switch (address >> 1) {
+    case 0x3C:
+      return &host::panel;
+    case 0x3D:
+      return &host::status_panel;
+    default:
+      return nullptr;
+  }
+}
+
+// all I2C writes go to the displays, the RTC is faked above its driver
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef*, uint16_t address, uint16_t reg_addr, uint16_t, uint8_t* data,
+                                    uint16_t len, uint32_t) {
+  host::Panel* panel = panel_at(address);
+  if (not panel) {
+    return HAL_ERROR;
+  }
+  panel->write(reg_addr, data, len);
+  return HAL_OK;
+}
+
+// transfers are done immediately
+bool RTOS_I2C::write_register_start(uint8_t address, uint8_t reg_addr, uint8_t* data, size_t len) {
+  host::Panel* panel = panel_at(address);
+  if (not panel) {
+    return false;
+  }
+  panel->write(reg_addr, data, len);
+  return true;
+}
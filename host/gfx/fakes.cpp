@@ -0,0 +1,99 @@
+/**
+ * @file fakes.cpp
+ * @brief Globals of the firmware, and fakes of the hardware used by the screens
+ *
+ */
+
+#include "host_display.h"
+#include "globals.h"
+#include "display_objects.h"
+
+#include <cstdio>
+
+namespace host {
+  Rtc rtc;
+  uint32_t tick{ 0 };
+  std::size_t free_heap{ 4096 };
+}  // namespace host
+
+
+// globals of main.cpp and display_task_main.cpp
+RTOS_I2C i2c;
+DS3231 rtc(i2c);
+UART_DMA uart2(nullptr, nullptr);
+TIM_HandleTypeDef htim2;
+Menu menu;
+Display display(i2c);
+GFX gfx(&display);
+FrameScheduler scheduler;
+Display status_display(i2c, 0x3D);
+GFX status_gfx(&status_display);
+
+
+// HAL
+uint32_t HAL_GetTick(void) {
+  return host::tick;
+}
+
+void HAL_TIM_Base_Start(TIM_HandleTypeDef*) {
+}
+void HAL_TIM_Base_Stop(TIM_HandleTypeDef*) {
+}
+void HAL_TIM_OC_Start(TIM_HandleTypeDef*, uint32_t) {
+}
+void HAL_TIM_OC_Stop(TIM_HandleTypeDef*, uint32_t) {
+}
+
+// FreeRTOS
+size_t xPortGetFreeHeapSize(void) {
+  return host::free_heap;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t, uint32_t, eNotifyAction) {
+  return pdPASS;
+}
+
+// there is only one task, the mutexes are always free
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) {
+  return pdTRUE;
+}
+BaseType_t xSemaphoreGive(SemaphoreHandle_t) {
+  return pdTRUE;
+}
+
+
+// transfers of the fake display are done immediately
+bool RTOS_I2C::finish_transfer(TickType_t) {
+  return true;
+}
+
+
+// the RTC returns the scripted state
+uint8_t DS3231::get_time(time& t) {
+  t = host::rtc.time;
+  return host::rtc.time_valid ? 0 : 1;
+}
+
+uint8_t DS3231::read_temperature(float& f) {
+  f = host::rtc.temperature;
+  return host::rtc.temperature_valid ? 0 : 1;
+}
+
+uint8_t DS3231::get_alarm(int n, alarm_t& a) {
+  a = host::rtc.alarms[n];
+  return host::rtc.alarm_valid[n] ? 0 : 1;
+}
+
+uint8_t DS3231::set_alarm(int n, const alarm_t& a) {
+  host::rtc.alarms[n] = a;
+  return 0;
+}
+
+
+// messages of the screens go to stdout
+UART_DMA::UART_DMA(hw_init_fcn_t*, isr_enable_fcn_t*) {
+}
+
+uint16_t UART_DMA::vprintf(const char* fmt, va_list args) {
+  return std::vprintf(fmt, args);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file host_display.h
+ * @brief State of the fakes of the host build, the display controller and the scripted RTC
+ *
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "DS3231.h"
+
+namespace host {
+
+  /// 128x64 1 bit image, pixel x, y is true if lit
+  using image_t = std::array<std::array<bool, 64>, 128>;
+
+  /**
+   * @brief Model of the display controller, which receives the I2C writes of the real driver
+   * @details Decodes the control bytes and the commands of the SSD1306, or of the SH1106 with DISPLAY_SH1106, and
+   * keeps the RAM like the controller does. Only the data the driver really sends (e.g. only dirty blocks) is stored,
+   * and the addressing of the driver is checked on the way.
+   */
+  struct Panel {
+    static constexpr int ram_columns = 132;  ///< Columns of the SH1106 RAM, the SSD1306 uses the first 128
+
+    std::array<std::array<uint8_t, 8>, ram_columns> ram{};  ///< [column][page], the top row of a page is the MSB
+    uint8_t start_line{ 0 };                                 ///< RAM row shown in the top row, moves the picture down
+    uint8_t mode{ 2 };                                       ///< Addressing mode, 0 horizontal, 1 vertical, 2 page
+    uint8_t column{ 0 };                                     ///< Column of the next data byte
+    uint8_t page{ 0 };                                       ///< Page of the next data byte
+    uint8_t first_column{ 0 }, last_column{ 127 };           ///< Column window of horizontal and vertical addressing
+    uint8_t first_page{ 0 }, last_page{ 7 };                 ///< Page window of horizontal and vertical addressing
+    std::array<uint8_t, 7> cmd{};                            ///< Command being received, with its arguments
+    uint8_t cmd_len{ 0 };                                    ///< Bytes of cmd received
+    uint32_t bytes_sent{ 0 };                                ///< Pixel data bytes sent over I2C
+    uint32_t transfers{ 0 };                                 ///< I2C transfers with pixel data
+    uint32_t commands{ 0 };                                  ///< Command bytes sent, e.g. windows and the start line
+    uint32_t errors{ 0 };                                    ///< Commands the controller doesn't have
+
+    /// An I2C write to the display, @p control is the first control byte, which the driver sends as register address
+    void write(uint8_t control, const uint8_t* data, std::size_t len);
+
+    /// Pixels shown on the display
+    image_t image() const;
+
+  private:
+    void command(uint8_t byte);
+    void data(uint8_t byte);
+  };
+  extern Panel panel;         ///< The display at 0x3C
+  extern Panel status_panel;  ///< The second display at 0x3D, see STATUS_DISPLAY
+
+  /// State returned by the fake DS3231
+  struct Rtc {
+    bool time_valid{ true };
+    DS3231::time time{};
+    bool temperature_valid{ true };
+    float temperature{ 21.5f };
+    bool alarm_valid[2]{ true, true };
+    DS3231::alarm_t alarms[2]{};
+  };
+  extern Rtc rtc;
+
+  /// Value returned by HAL_GetTick()
+  extern uint32_t tick;
+
+  /// Value returned by xPortGetFreeHeapSize()
+  extern std::size_t free_heap;
+
+  /// Write @p img as plain PBM(P1). @return false on error
+  bool write_pbm(const std::string& path, const image_t& img);
+
+  /// Read a plain PBM(P1) written by write_pbm(). @return false on error
+  bool read_pbm(const std::string& path, image_t& img);
+
+}  // namespace host
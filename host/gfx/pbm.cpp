@@ -0,0 +1,46 @@
+/**
+ * @file pbm.cpp
+ * @brief Plain PBM images, they are readable and diffable as text
+ *
+ */
+
+#include "host_display.h"
+
+#include <fstream>
+
+namespace host {
+
+  bool write_pbm(const std::string& path, const image_t& img) {
+    std::ofstream f(path);
+    f << "P1\n128 64\n";
+    for (int y = 0; y < 64; ++y) {
+      for (int x = 0; x < 128; ++x) {
+        f << (img[x][y] ? '1' : '0');
+      }
+      f << '\n';
+    }
+    return static_cast<bool>(f);
+  }
+
+  bool read_pbm(const std::string& path, image_t& img) {
+    std::ifstream f(path);
+    std::string magic;
+    int w = 0, h = 0;
+    f >> magic >> w >> h;
+    if (not f || magic != "P1" || w != 128 || h != 64) {
+      return false;
+    }
+    for (int y = 0; y < 64; ++y) {
+      for (int x = 0; x < 128; ++x) {
+        char c = 0;
+        f >> c;
+        if (c != '0' && c != '1') {
+          return false;
+        }
+        img[x][y] = c == '1';
+      }
+    }
+    return static_cast<bool>(f);
+  }
+
+}  // namespace host
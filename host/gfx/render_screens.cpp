@@ -0,0 +1,531 @@
+/**
+ * @file render_screens.cpp
+ * @brief Renders GFX drawing and the screens of src/display for scripted states, and compares them to golden images
+ *
+ * Usage:
+ *  - render_screens: compare every scene with golden/<scene>.pbm, a differing render is written to out/<scene>.pbm
+ *  - render_screens --update: write the renders as the new golden images
+ *  - render_screens --bench: time the drawing routines and frames of the screens
+ */
+
+#include "host_display.h"
+#include "display_objects.h"
+#include "screens.h"
+#include "format.h"
+#include "nanoprintf.h"
+#include "assets.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+  /// A frame like Menu::tick draws it
+  void frame(AbstractScreen& screen) {
+    screen.update();
+    gfx.first_page();
+    do {
+      screen.draw();
+    } while (gfx.next_page());
+    screen.drawn();
+  }
+
+  /// A frame of a transition like Menu::tick draws it, showing @p rows of it
+  void transition_frame(AbstractScreen& screen, uint8_t rows) {
+    screen.update();
+    gfx.first_page();
+    screen.draw();
+    gfx.transition_step(rows);
+    screen.drawn();
+  }
+
+  /// Like frame(), for drawing directly with gfx
+  template <class F>
+  void gfx_frame(F draw) {
+    gfx.first_page();
+    do {
+      gfx.clear_canvas();
+      draw();
+    } while (gfx.next_page());
+  }
+
+  /// Blank display and default state
+  void reset() {
+    host::panel = {};
+    host::status_panel = {};
+    display.begin();
+    status_display.begin();
+    gfx.invalidate();
+    status_gfx.invalidate();
+    gfx.set_font(fonts::font1);
+    host::tick = 1000;
+    host::rtc = host::Rtc{};
+  }
+
+  /**
+   * @brief Shows screen S in the state set by @p script
+   * @details @p setup is run before the screen is entered. The screen first draws the @p previous state, and then the
+   * scripted one on top of it, as the widgets only redraw what changed. A new screen drawing the scripted state from
+   * scratch has to give the same image.
+   * @return false, if the images differ
+   */
+  template <class S, class... Args>
+  bool show(void (*setup)(), void (*previous)(S&), void (*script)(S&), Args... args) {
+    reset();
+    setup();
+    S retained(args...);
+    retained.onEntry();
+    previous(retained);
+    frame(retained);
+    script(retained);
+    frame(retained);
+    const auto image = host::panel.image();
+
+    reset();
+    setup();
+    S fresh(args...);
+    fresh.onEntry();
+    script(fresh);
+    frame(fresh);
+    return image == host::panel.image();
+  }
+
+  /// Nothing to do
+  template <class... Args>
+  void none(Args&...) {
+  }
+
+
+  void rtc_state() {
+    host::rtc.time = {
+      .sec = 9, .min = 5, .hour = 7, .dow = 1, .date = 19, .month = 10, .year = 2026, .dow_str = "Mon"
+    };
+    host::rtc.temperature = 21.75f;
+    host::rtc.alarms[0] = { .hour = 6, .min = 30, .en = true };
+    host::rtc.alarms[1] = { .hour = 7, .min = 45, .dow = 3, .en = true, .alarm_type = DS3231::alarm_t::ON_DOW };
+  }
+
+  void main_previous(MainScreen&) {
+    host::rtc.time = {
+      .sec = 59, .min = 59, .hour = 23, .dow = 7, .date = 18, .month = 10, .year = 2026, .dow_str = "Sun"
+    };
+    host::rtc.temperature = -5;
+    host::rtc.alarms[1].en = false;
+  }
+
+  void main_current(MainScreen&) {
+    rtc_state();
+  }
+
+  void main_second_before(MainScreen&) {
+    rtc_state();
+    host::rtc.time.sec = 8;
+  }
+
+  void main_no_rtc(MainScreen&) {
+    host::rtc.time_valid = false;
+    host::rtc.temperature_valid = false;
+    host::rtc.alarm_valid[0] = host::rtc.alarm_valid[1] = false;
+  }
+
+  void menu_third(MainMenuScreen& s) {
+    s.onEncoder(1);
+    s.onEncoder(1);
+  }
+
+  void set_alarm_hour_hidden(SetAlarmScreen& s) {
+    // edit the hour, in the off phase of the blink
+    s.onClickHeld();
+    host::tick += 1000;
+  }
+
+  void alarm_border(AlarmScreen&) {
+    host::tick += 500;
+  }
+
+
+  struct Scene {
+    const char* name;
+    bool (*render)();                           ///< @return false, if the scene detected an error itself
+    const host::Panel* panel{ &host::panel };  ///< Display compared with the golden image
+  };
+
+  const Scene scenes[] = {
+    { "text",
+      [] {
+        gfx_frame([] {
+          gfx.move_cursor({ 0, 0 });
+          gfx.draw_text("Hello world!\n\tTab\r");
+          gfx.printf("%s %d%c", "Five:", 5, '?');
+          gfx.draw_char({ 100, 45 }, 'g');
+          gfx.draw_char({ -3, 60 }, 'X');
+        });
+        return true;
+      } },
+    { "shapes",
+      [] {
+        gfx_frame([] {
+          gfx.draw_circle({ 20, 20 }, 15);
+          gfx.draw_circle_outline({ 60, 32 }, 20);
+          gfx.draw_rectangle({ 90, 5 }, { 120, 58 });
+          gfx.draw_rectangle({ 95, 10 }, { 115, 53 }, false);
+          gfx.draw_line({ 0, 63 }, { 127, 40 });
+          gfx.draw_circle({ 127, 0 }, 10);
+        });
+        return true;
+      } },
+    { "blit",
+      [] {
+        gfx_frame([] {
+          gfx.draw_circle({ 10, 10 }, 8);
+          gfx.blit({ 0, 0 }, { 20, 20 }, { 30, 5 }, GFX::RasterOp::NOT);
+          gfx.blit({ 0, 0 }, { 20, 20 }, { 40, 30 }, GFX::RasterOp::XOR);
+          gfx.move_cursor({ 0, 6 });
+          gfx.draw_text("scroll");
+          gfx.scroll({ 0, 48 }, { 63, 63 }, 5, -3);
+          gfx.invert_rect({ 70, 0 }, { 127, 20 });
+        });
+        return true;
+      } },
+    { "image",
+      [] {
+        // the compressed image has to give the same pixels as the uncompressed bitmap, unaligned, clipped, combined
+        // with the canvas and in a viewport
+        const auto& image = assets::clock;
+        static uint8_t bitmap[128 * 8];
+        for (uint8_t band = 0; band < image.bands(); ++band) {
+          images::BandReader reader(image, band);
+          for (int x = 0; x < image.width_; ++x) {
+            bitmap[x * image.bands() + band] = reader.next();
+          }
+        }
+        static bool compressed;
+        const auto draw = [] {
+          gfx_frame([] {
+            const auto put = [](const Pixel& pos, GFX::RasterOp op) {
+              if (compressed) {
+                gfx.draw_image(assets::clock, pos, op);
+              } else {
+                gfx.blit_bitmap(bitmap, assets::clock.width_, assets::clock.height_, pos, op);
+              }
+            };
+            gfx.draw_rectangle({ 60, 20 }, { 127, 40 });
+            put({ -20, 3 }, GFX::RasterOp::COPY);
+            put({ 70, 13 }, GFX::RasterOp::XOR);
+            gfx.set_viewport({ 0, 40 }, { 50, 63 });
+            put({ -5, -3 }, GFX::RasterOp::OR);
+            gfx.reset_viewport();
+          });
+        };
+        compressed = false;
+        draw();
+        const auto expected = host::panel.image();
+        reset();
+        compressed = true;
+        draw();
+        return expected == host::panel.image();
+      } },
+    { "digits",
+      [] {
+        gfx_frame([] {
+          gfx.set_font(fonts::digits);
+          gfx.move_cursor({ 0, 0 });
+          gfx.draw_text("12:34");
+          gfx.draw_char({ 80, 30 }, '5');
+          gfx.draw_char({ 100, 30 }, ':');
+          gfx.set_font(fonts::font1);
+        });
+        return true;
+      } },
+    { "layout",
+      [] {
+        gfx_frame([] {
+          gfx.draw_rectangle({ 0, 0 }, { 127, 7 }, false);
+          gfx.draw_text_aligned({ 0, 0 }, 128, GFX::Align::LEFT, "Left");
+          gfx.draw_text_aligned({ 0, 1 }, 128, GFX::Align::CENTER, "Center");
+          gfx.printf_aligned({ 0, 2 }, 128, GFX::Align::RIGHT, "%d right", 3);
+          gfx.draw_text_aligned({ 8, 3 }, 100, GFX::Align::CENTER, "Truncated to the box");
+          gfx.draw_text_wrapped({ 0, 4 }, 128, 3, "Wrapped at the spaces\nnew line and truncated at the end");
+          gfx.draw_text_wrapped({ 100, 7 }, 20, 1, "X");
+        });
+        return true;
+      } },
+    { "utf8",
+      [] {
+        // UTF-8 text is drawn and measured by characters, printf gets it byte by byte. 'ñ' has no glyph and is skipped
+        // like a space, like the broken sequence
+        static const char* const text = "S\xC3\xA1" "b, mi\xC3\xA9rcoles";
+        gfx_frame([] {
+          gfx.move_cursor({ 0, 0 });
+          gfx.draw_text(text);
+          gfx.move_cursor({ 0, 2 });
+          gfx.printf("%s", text);
+          gfx.draw_text_aligned({ 0, 4 }, 128, GFX::Align::RIGHT, "Atr\xC3\xA1s");
+          gfx.draw_text_aligned({ 0, 5 }, 128, GFX::Align::LEFT, "a\xC3\xB1o \xC3 \xA9!");
+          // 8 of 10 characters fit on a line, the break is between the sequences
+          gfx.draw_text_wrapped({ 0, 6 }, 64, 2, "\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9"
+                                                 "\xC3\xA9\xC3\xA9");
+        });
+        const auto image = host::panel.image();
+        bool same = gfx.text_width(text) == 14 * 8;
+        for (int x = 0; x < 128; ++x) {
+          for (int y = 0; y < 8; ++y) {
+            same = same && image[x][y] == image[x][y + 16];
+          }
+        }
+        return same;
+      } },
+    { "viewport",
+      [] {
+        gfx_frame([] {
+          // nothing is smeared onto the edges
+          gfx.set_pixel({ 200, 10 });
+          gfx.draw_line({ -20, 70 }, { 140, 70 });
+          gfx.draw_char({ 0, -8 }, 'X');
+
+          // a panel with its own coordinates, which text wraps in
+          gfx.set_viewport({ 70, 4 }, { 121, 35 });
+          gfx.draw_rectangle({ 0, 0 }, { 51, 31 });
+          gfx.set_clip({ 1, 1 }, { 50, 30 });
+          gfx.clear_viewport();
+          gfx.draw_circle({ 50, 30 }, 12);
+          gfx.move_cursor({ 0, 0 });
+          gfx.draw_text("Text in a panel");
+          gfx.reset_viewport();
+
+          // a status bar on the bottom line
+          gfx.set_viewport({ 0, 56 }, { 127, 63 });
+          gfx.invert_rect({ 0, 0 }, { 127, 7 });
+          gfx.draw_text_aligned({ 0, 0 }, 128, GFX::Align::CENTER, "status");
+          gfx.scroll({ 0, 0 }, { 127, 7 }, 0, 2);
+          gfx.reset_viewport();
+        });
+        return true;
+      } },
+    { "transition",
+      [] {
+        // the menu pushes the main screen up, each step has to show the bottom of one above the top of the other
+        rtc_state();
+        MainScreen main;
+        main.onEntry();
+        frame(main);
+        const auto last = host::panel.image();
+
+        MainMenuScreen next;
+        next.onEntry();
+        if (not gfx.begin_transition()) {
+          // without GFX_DOUBLE_BUFFER the menu is just drawn
+          frame(next);
+          return true;
+        }
+        constexpr uint8_t rows[] = { 5, 13, 16, 40 };
+        host::image_t steps[std::size(rows)];
+        for (std::size_t i = 0; i < std::size(rows); ++i) {
+          transition_frame(next, rows[i]);
+          steps[i] = host::panel.image();
+        }
+        gfx.end_transition();
+        frame(next);
+
+        const auto image = host::panel.image();
+        for (std::size_t i = 0; i < std::size(rows); ++i) {
+          for (int x = 0; x < 128; ++x) {
+            for (int y = 0; y < 64; ++y) {
+              const int top = 64 - rows[i];
+              if (steps[i][x][y] != (y < top ? last[x][y + rows[i]] : image[x][y - top])) {
+                return false;
+              }
+            }
+          }
+        }
+        return true;
+      } },
+    { "status",
+      [] {
+        // both displays drawn by the scheduler, in turns, the main one has to look like it was drawn alone
+        rtc_state();
+        host::tick = ((2 * 24 + 5) * 60 + 7) * 60000;
+        host::rtc.temperature = 22.0f;
+        MainScreen alone;
+        frame(alone);
+        const auto image = host::panel.image();
+
+        reset();
+        rtc_state();
+        host::tick = ((2 * 24 + 5) * 60 + 7) * 60000;
+        MainScreen main;
+        StatusScreen status;
+        for (int i = 0; i < 2; ++i) {
+          main.update();
+          status.update();
+          scheduler.submit(gfx, main);
+          scheduler.submit(status_gfx, status);
+          scheduler.run();
+          // the second frame only redraws what changed
+          host::rtc.temperature = 22.0f;
+        }
+        return image == host::panel.image() && not scheduler.pending();
+      },
+      &host::status_panel },
+    { "splash", [] { return show<SplashScreen>(none, none, none); } },
+    { "main", [] { return show<MainScreen>(rtc_state, main_previous, main_current); } },
+    { "main_tick", [] { return show<MainScreen>(rtc_state, main_second_before, main_current); } },
+    { "main_no_rtc", [] { return show<MainScreen>(rtc_state, none, main_no_rtc); } },
+    { "menu", [] { return show<MainMenuScreen>(none, none, menu_third); } },
+    { "set_alarm", [] { return show<SetAlarmScreen>(rtc_state, none, none, 1); } },
+    { "set_alarm_blink", [] { return show<SetAlarmScreen>(rtc_state, none, set_alarm_hour_hidden, 1); } },
+    { "alarm", [] { return show<AlarmScreen>(none, none, alarm_border, 0); } },
+  };
+
+
+  int compare(bool update) {
+    int failed = 0;
+    std::filesystem::create_directories(update ? "golden" : "out");
+    for (const auto& scene : scenes) {
+      reset();
+      const bool ok = scene.render();
+      const auto image = scene.panel->image();
+      const std::string golden = std::string("golden/") + scene.name + ".pbm";
+
+      if (update) {
+        host::write_pbm(golden, image);
+        std::printf("%-16s written\n", scene.name);
+        continue;
+      }
+
+      host::image_t expected{};
+      const char* result = "ok";
+      if (not ok) {
+        result = "FAIL, the check of the scene, e.g. redrawing the changed widgets like a full redraw";
+      } else if (host::panel.errors || host::status_panel.errors) {
+        result = "FAIL, the driver sent commands the controller doesn't have";
+      } else if (not host::read_pbm(golden, expected)) {
+        result = "FAIL, no golden image";
+      } else if (expected != image) {
+        result = "FAIL, differs from the golden image";
+      }
+      if (std::strcmp(result, "ok") != 0) {
+        ++failed;
+        host::write_pbm(std::string("out/") + scene.name + ".pbm", image);
+      }
+      std::printf("%-16s %s\n", scene.name, result);
+    }
+    return failed;
+  }
+
+
+  /// Runs @p f @p n times, and prints the time per run
+  template <class F>
+  void bench(const char* name, int n, F f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+      f(i);
+    }
+    const std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+    std::printf("%-28s %9.3f us\n", name, took.count() / n);
+  }
+
+  /// Keeps the compiler from dropping the writes to @p buf
+  void keep(const char* buf) {
+    asm volatile("" : : "r"(buf) : "memory");
+  }
+
+  void benchmark() {
+    constexpr int n = 20000;
+    reset();
+    bench("text, 8 lines", n, [](int) {
+      gfx.move_cursor({ 0, 0 });
+      for (int line = 0; line < 8; ++line) {
+        gfx.draw_text("0123456789ABCDE\n");
+      }
+    });
+    bench("text, unaligned", n, [](int i) {
+      for (int x = 0; x < 120; x += 8) {
+        gfx.draw_char({ x, 3 + i % 4 }, 'A' + x / 8);
+      }
+    });
+    bench("large digits", n, [](int) {
+      gfx.set_font(fonts::digits);
+      gfx.move_cursor({ 0, 0 });
+      gfx.draw_text("12:34");
+      gfx.set_font(fonts::font1);
+    });
+    bench("filled circle r=30", n, [](int) { gfx.draw_circle({ 64, 32 }, 30); });
+    bench("line", n, [](int) { gfx.draw_line({ 0, 0 }, { 127, 63 }); });
+    bench("scroll full screen", n, [](int) { gfx.scroll({ 0, 0 }, { 127, 63 }, 0, -1); });
+    bench("invert full screen", n, [](int) { gfx.invert_rect({ 0, 0 }, { 127, 63 }); });
+    bench("draw(), nothing changed", n, [](int) { gfx.draw(); });
+
+    static char buf[32];
+    bench("date, npf_snprintf", n, [](int i) {
+      npf_snprintf(buf, sizeof(buf), "%d.%2d.%4d %.*s", 1 + i % 31, 1 + i % 12, 2026, 3, "Monday");
+      keep(buf);
+    });
+    bench("date, format.h", n, [](int i) {
+      char* end = format::date(buf, 1 + i % 31, 1 + i % 12, 2026);
+      *end++ = ' ';
+      *format::text(end, "Monday", 3) = '\0';
+      keep(buf);
+    });
+    bench("HH:MM:SS, npf_snprintf", n, [](int i) {
+      npf_snprintf(buf, sizeof(buf), "%02d:%02d:%02d", i % 24, i % 60, i % 59);
+      keep(buf);
+    });
+    bench("HH:MM:SS, format.h", n, [](int i) {
+      *format::hh_mm_ss(buf, i % 24, i % 60, i % 59) = '\0';
+      keep(buf);
+    });
+
+    reset();
+    rtc_state();
+    MainScreen screen;
+    frame(screen);
+    host::panel.bytes_sent = 0;
+    bench("main screen, idle frame", n, [&](int) { frame(screen); });
+    std::printf("%-28s %9u bytes\n", "  sent", host::panel.bytes_sent);
+
+    host::panel.bytes_sent = 0;
+    bench("main screen, seconds tick", n, [&](int i) {
+      host::rtc.time.sec = i % 60;
+      frame(screen);
+    });
+    std::printf("%-28s %9.1f bytes per frame\n", "  sent", host::panel.bytes_sent / static_cast<double>(n));
+
+    bench("main screen, full redraw", n, [&](int) {
+      screen.invalidate();
+      frame(screen);
+    });
+
+    // the frames of a transition to the menu, like Menu shows them
+    constexpr int transition_frames = 13;
+    frame(screen);
+    host::panel.bytes_sent = 0;
+    host::panel.commands = 0;
+    if (gfx.begin_transition()) {
+      MainMenuScreen next;
+      for (int f = 1; f <= transition_frames; ++f) {
+        transition_frame(next, 64 * f / transition_frames);
+      }
+      gfx.end_transition();
+      std::printf("%-28s %9.1f bytes, %.1f command bytes per frame\n", "transition to the menu",
+                  host::panel.bytes_sent / static_cast<double>(transition_frames),
+                  host::panel.commands / static_cast<double>(transition_frames));
+    } else {
+      std::printf("%-28s %9s\n", "transition to the menu", "needs -DGFX_DOUBLE_BUFFER");
+    }
+  }
+
+}  // namespace
+
+
+int main(int argc, char** argv) {
+  if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+    benchmark();
+    return 0;
+  }
+  const bool update = argc > 1 && std::strcmp(argv[1], "--update") == 0;
+  return compare(update) ? 1 : 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+// Declarations of FreeRTOS used by the headers of the firmware, for the host build
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void* QueueHandle_t;
+
+#define pdPASS 1
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(x) (x)
+#define portENTER_CRITICAL() ((void)0)
+#define portEXIT_CRITICAL() ((void)0)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+#define configASSERT(x) ((void)0)
+
+void* pvPortMalloc(size_t);
+size_t xPortGetFreeHeapSize(void);
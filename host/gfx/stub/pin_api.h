@@ -0,0 +1,9 @@
+#pragma once
+// The pins aren't used on the host
+
+enum class pin_mode_t { ALTERNATE_PP, ALTERNATE_OD_PU };
+namespace pins {
+  constexpr int sda1 = 0, scl1 = 1, rx = 2, tx = 3, rx1 = 4, tx1 = 5;
+}
+inline void pin_mode(int, pin_mode_t, int = 0) {
+}
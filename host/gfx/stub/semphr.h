@@ -0,0 +1,9 @@
+#pragma once
+#include "FreeRTOS.h"
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t);
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t, BaseType_t*);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t, BaseType_t*);
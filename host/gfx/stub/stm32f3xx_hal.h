@@ -0,0 +1,84 @@
+#pragma once
+// Types and declarations of the HAL used by the headers of the firmware, for the host build
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum { HAL_OK, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+#define UNUSED(x) ((void)(x))
+#define __weak __attribute__((weak))
+#define assert_param(x) ((void)0)
+
+typedef struct {
+  void* Instance;
+} DMA_HandleTypeDef;
+
+typedef struct {
+  uint32_t CR1;
+} USART_TypeDef;
+
+typedef struct {
+  USART_TypeDef* Instance;
+  DMA_HandleTypeDef* hdmatx;
+  DMA_HandleTypeDef* hdmarx;
+} UART_HandleTypeDef;
+
+typedef struct {
+  uint32_t Timing, OwnAddress1, AddressingMode, DualAddressMode, OwnAddress2, OwnAddress2Masks, GeneralCallMode,
+      NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct {
+  void* Instance;
+  I2C_InitTypeDef Init;
+  DMA_HandleTypeDef* hdmatx;
+  DMA_HandleTypeDef* hdmarx;
+} I2C_HandleTypeDef;
+
+typedef enum {
+  HAL_I2C_MSPINIT_CB_ID,
+  HAL_I2C_MEM_TX_COMPLETE_CB_ID,
+  HAL_I2C_MASTER_TX_COMPLETE_CB_ID,
+  HAL_I2C_ERROR_CB_ID,
+} HAL_I2C_CallbackIDTypeDef;
+typedef void (*pI2C_CallbackTypeDef)(I2C_HandleTypeDef*);
+
+typedef struct {
+  void* Instance;
+} TIM_HandleTypeDef;
+
+typedef struct {
+  uint32_t IDR;
+} GPIO_TypeDef;
+
+#define I2C1 ((void*)0x40005400)
+#define TIM_CHANNEL_2 4
+#define I2C_ADDRESSINGMODE_7BIT 1
+#define I2C_DUALADDRESS_DISABLE 0
+#define I2C_OA2_NOMASK 0
+#define I2C_GENERALCALL_DISABLE 0
+#define I2C_NOSTRETCH_DISABLE 0
+#define I2C_ANALOGFILTER_ENABLE 0
+#define I2C_MEMADD_SIZE_8BIT 1
+#define GPIO_AF4_I2C1 4
+#define __HAL_RCC_I2C1_CLK_ENABLE() ((void)0)
+
+HAL_StatusTypeDef HAL_I2C_RegisterCallback(I2C_HandleTypeDef*, HAL_I2C_CallbackIDTypeDef, pI2C_CallbackTypeDef);
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef*);
+HAL_StatusTypeDef HAL_I2CEx_ConfigAnalogFilter(I2C_HandleTypeDef*, uint32_t);
+HAL_StatusTypeDef HAL_I2CEx_ConfigDigitalFilter(I2C_HandleTypeDef*, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef*, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef*, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t*, uint16_t);
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef*, uint8_t*, uint16_t, uint32_t);
+
+uint32_t HAL_GetTick(void);
+void HAL_TIM_Base_Start(TIM_HandleTypeDef*);
+void HAL_TIM_Base_Stop(TIM_HandleTypeDef*);
+void HAL_TIM_OC_Start(TIM_HandleTypeDef*, uint32_t);
+void HAL_TIM_OC_Stop(TIM_HandleTypeDef*, uint32_t);
@@ -0,0 +1,99 @@
+/**
+ * @file bench_string_parser.cpp
+ * @brief Throughput benchmark for StringParser
+ * @details Every input is repeated into a stream of about stream_size bytes, which is fed into the parser. For each
+ * parsed command, the parameters are queried like CommandDispatcher would. Reports commands/s and ns/byte.
+ */
+
+#include "string_parser.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+/// Approximate size of each stream in bytes
+static constexpr size_t stream_size = 4 * 1024 * 1024;
+
+/// One benchmarked input
+struct bench_input_t {
+  const char* name;  ///< name in report
+  std::string line;  ///< repeated to create the stream
+};
+
+/// Prevents the compiler from optimizing out the parsing
+static volatile int32_t sink;
+
+
+/// Feeds @p stream into a parser, returns the number of parsed commands
+static size_t run(const std::string& stream) {
+  StringParser parser;
+  size_t commands = 0;
+  int32_t acc = 0;
+  for (char c : stream) {
+    if (parser.tick(c)) {
+      ++commands;
+      acc += parser.get_prefix() + parser.get_code();
+      int16_t val;
+      for (char p : { 'H', 'M', 'S', 'N', 'A' }) {
+        parser.get_parameter(p, val);
+        acc += val;
+      }
+    }
+  }
+  sink = acc;
+  return commands;
+}
+
+
+static void bench(const bench_input_t& in) {
+  std::string stream;
+  while (stream.size() < stream_size) {
+    stream += in.line;
+  }
+
+  run(stream);  // warm-up
+
+  using clock = std::chrono::steady_clock;
+  constexpr int repeats = 5;
+  double best_ns = 1e30;
+  size_t commands = 0;
+  for (int i = 0; i < repeats; ++i) {
+    const auto start = clock::now();
+    commands = run(stream);
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    best_ns = std::min(best_ns, elapsed.count());
+  }
+
+  printf("%-22s %10zu %14.0f %10.2f\n", in.name, commands, commands / best_ns * 1e9, best_ns / stream.size());
+}
+
+
+int main() {
+  std::string noise;
+  std::mt19937 rng(1234);
+  for (int i = 0; i < 4096; ++i) {
+    noise += static_cast<char>(rng());
+  }
+
+  const bench_input_t inputs[] = {
+    // realistic
+    { "get time", "A0\n" },
+    { "set time", "A1 H10 M20 S30 A1 B2 C2022 D3\n" },
+    { "set alarm", "A2 N0 H7 M30 D1 A1 B1\n" },
+    { "batch", "A1 H10 M20; A2 N0 H7 M30; A3 N0\n" },
+    { "define macro", "M1 \"boot\" \"A1 H7 M0;A2 N0 H6\"\n" },
+    // adversarial
+    { "overflow", std::string(1000, 'A') + "\n" },
+    { "huge numbers", "A99999999999 H99999999999 M-9999999999\n" },
+    { "quotes", std::string(60, '"') + "\n" },
+    { "separators only", std::string(1000, ';') + "\n" },
+    { "whitespace", std::string(1000, ' ') + "\n" },
+    { "binary noise", noise },
+  };
+
+  printf("%-22s %10s %14s %10s\n", "input", "commands", "commands/s", "ns/byte");
+  for (const auto& in : inputs) {
+    bench(in);
+  }
+  return 0;
+}
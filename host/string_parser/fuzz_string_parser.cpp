@@ -0,0 +1,105 @@
+/**
+ * @file fuzz_string_parser.cpp
+ * @brief libFuzzer entry point for StringParser
+ * @details Feeds arbitrary bytes into the parser, and checks the invariants of every parsed command. Build with
+ * -DFUZZ_STANDALONE to get a main() that replays files, e.g. the corpus, without libFuzzer.
+ */
+
+#include "string_parser.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/// @brief Like assert, but also active in release builds, so the fuzzer catches it
+#define REQUIRE(x)                                                                                                     \
+  do {                                                                                                                 \
+    if (!(x)) {                                                                                                        \
+      fprintf(stderr, "%s:%d: REQUIRE(%s) failed\n", __FILE__, __LINE__, #x);                                        \
+      abort();                                                                                                         \
+    }                                                                                                                  \
+  } while (0)
+
+
+/// Queries everything the dispatcher and the commands could query, and checks the results
+static void check_command(const StringParser& parser) {
+  const char* const cmd = parser.get_str();
+  const size_t cmd_len = strlen(cmd);
+  REQUIRE(cmd_len < 64);
+  // a truncated command is reported, but never run
+  REQUIRE(not(parser.is_overflow() && parser.is_valid()));
+
+  if (not parser.is_valid()) {
+    return;
+  }
+  REQUIRE(std::isupper(static_cast<unsigned char>(parser.get_prefix())));
+  REQUIRE(std::isdigit(static_cast<unsigned char>(cmd[1])));
+
+  for (int p = 0; p < 256; ++p) {
+    int16_t val = 0;
+    parser.get_parameter(static_cast<char>(p), val, 42);
+  }
+
+  const char* str{ nullptr };
+  size_t len{ 0 };
+  for (uint8_t n = 0; parser.get_string(n, str, len); ++n) {
+    // strings have to point into the command
+    REQUIRE(str > cmd && str + len <= cmd + cmd_len);
+    REQUIRE(memchr(str, '"', len) == nullptr);
+    REQUIRE(n < cmd_len);
+  }
+}
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  StringParser parser;
+  for (size_t i = 0; i < size; ++i) {
+    if (parser.tick(static_cast<char>(data[i]))) {
+      check_command(parser);
+    }
+    // a line always ends, even after a command which overflowed the buffer
+    if (StringParser::is_end_char(static_cast<char>(data[i]))) {
+      REQUIRE(parser.is_waiting());
+    }
+  }
+
+  // flush the last command, if any
+  if (parser.tick('\n')) {
+    check_command(parser);
+  }
+  REQUIRE(parser.is_waiting());
+  return 0;
+}
+
+
+#ifdef FUZZ_STANDALONE
+
+/// Replays the files given as arguments, or stdin
+int main(int argc, char** argv) {
+  auto run_file = [](FILE* f) {
+    std::vector<uint8_t> data;
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+      data.push_back(static_cast<uint8_t>(c));
+    }
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+  };
+
+  if (argc < 2) {
+    run_file(stdin);
+  }
+  for (int i = 1; i < argc; ++i) {
+    FILE* f = fopen(argv[i], "rb");
+    if (not f) {
+      fprintf(stderr, "Can't open %s\n", argv[i]);
+      return 1;
+    }
+    run_file(f);
+    fclose(f);
+  }
+  printf("Replayed %d input(s)\n", argc < 2 ? 1 : argc - 1);
+  return 0;
+}
+
+#endif
@@ -213,9 +213,16 @@ uint8_t DS3231::set_time(const time& t) {
 
 
 const char* DS3231::dow_to_str(uint8_t dow) const {
+  // UTF-8, the display decodes it
+#ifdef LANGUAGE_ES
+  static constexpr const char* lookup[] = {
+    "Lunes", "Martes", "Miércoles", "Jueves", "Viernes", "Sábado", "Domingo"
+  };
+#else
   static constexpr const char* lookup[] = {
     "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"
   };
+#endif
   static constexpr const char* empty = "";
 
   if (not utils::within(dow, 1, 7)) {
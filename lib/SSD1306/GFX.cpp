@@ -8,31 +8,60 @@
 #include "SSD1306/fonts.h"
 
 #include <cstring>
+#include <algorithm>
+#include <cstdlib>
 #include "utils.h"
 #include "main.h"
-#include "SSD1306.h"
 #include "nanoprintf.h"
 
 
 std::pair<uint8_t, uint8_t> GFX::get_page_and_mask(uint8_t row) const {
-  std::pair<uint8_t, uint8_t> ret{ 7 - (row / 8), (1 << (7 - row % 8)) };
+  std::pair<uint8_t, uint8_t> ret{ page_of(row), (1 << (7 - row % 8)) };
   return ret;
 }
 
 uint8_t& GFX::canvas_access(uint8_t i, uint8_t j) {
-  i = utils::constrain(i, 0, canvas_.size());
-  j = utils::constrain(j, 0, canvas_[0].size());
-  return canvas_[i][j];
+  const uint8_t canvas_page = j - first_page_;
+  if (canvas_page >= buffer_pages) {
+    outside_ = 0;
+    return outside_;
+  }
+  return canvas_[i][canvas_page];
 }
 
+uint8_t& GFX::canvas_write(uint8_t i, uint8_t j) {
+  const uint8_t canvas_page = j - first_page_;
+  if (canvas_page >= buffer_pages) {
+    return outside_;
+  }
+  written_[canvas_page] |= 1 << (i / block_width);
+  return canvas_[i][canvas_page];
+}
 
-void GFX::set_pixel(const Pixel& pix, bool val) {
-  auto [page, mask] = get_page_and_mask(pix.y_);
-  if (val) {
-    canvas_access(pix.x_, page) |= mask;
-  } else {
-    canvas_access(pix.x_, page) &= ~mask;
+#ifdef GFX_DOUBLE_BUFFER
+uint16_t GFX::block_signature(uint8_t page, uint8_t block) const {
+  // FNV-1a, folded to 16 bits
+  uint32_t h = 2166136261u;
+  for (int x = block * block_width; x < (block + 1) * block_width; ++x) {
+    h = (h ^ canvas_[x][page]) * 16777619u;
   }
+  return static_cast<uint16_t>(h ^ (h >> 16));
+}
+
+bool GFX::same_as_front(uint8_t page, uint8_t block) const {
+  for (int x = block * block_width; x < (block + 1) * block_width; ++x) {
+    if (canvas_[x][page] != front_[x][page]) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+
+void GFX::set_pixel(const Pixel& pix, bool val) {
+  const Pixel p = to_display(pix);
+  plot(p.x_, p.y_, val);
 }
 
 
@@ -42,8 +71,12 @@ void GFX::reset_pixel(const Pixel& pix) {
 
 
 bool GFX::get_pixel(const Pixel& pix) {
-  auto [page, mask] = get_page_and_mask(pix.y_);
-  return (canvas_access(pix.x_, page) & mask);
+  const Pixel p = to_display(pix);
+  if (not utils::within(p.x_, 0, width - 1) || not utils::within(p.y_, 0, height - 1)) {
+    return false;
+  }
+  auto [page, mask] = get_page_and_mask(p.y_);
+  return (canvas_access(p.x_, page) & mask);
 }
 
 void GFX::toggle_pixel(const Pixel& pix) {
@@ -51,109 +84,439 @@ void GFX::toggle_pixel(const Pixel& pix) {
 }
 
 void GFX::draw() {
-  assert_param(ssd_1306_ != nullptr);
+  assert_param(display_ != nullptr);
+
+  if (not display_) {
+    return;
+  }
+
+#ifdef GFX_DOUBLE_BUFFER
+  if (transition_) {
+    end_transition();
+  }
+
+  // front_ can't be touched, until the previous frame is out
+  if (flushing_) {
+    flushing_ = false;
+    if (not display_->wait_canvas()) {
+      invalidate();
+    }
+  }
+#endif
+
+  // the written blocks are sent
+  dirty_t changed = written_;
+#ifdef GFX_DOUBLE_BUFFER
+  // except the ones which are the same as on the display. A different signature means changed, an equal one has to be
+  // confirmed byte by byte against the front buffer, which holds what was sent
+  for (uint8_t page = 0; page < pages; ++page) {
+    const bool valid = sent_valid_ & (1 << page);
+    for (uint8_t block = 0; block < num_blocks; ++block) {
+      if (not(written_[page] & (1 << block))) {
+        continue;
+      }
+      const auto sig = block_signature(page, block);
+      if (valid && sig == sent_[page][block] && same_as_front(page, block)) {
+        changed[page] &= ~(1 << block);
+      }
+      sent_[page][block] = sig;
+    }
+  }
+#endif
+  written_ = {};
+
+  // pages of the canvas
+  const uint8_t pages_mask = ((1 << buffer_pages) - 1) << first_page_;
+
+#ifdef GFX_DOUBLE_BUFFER
+  // a window per changed page sends the least data, like without the double buffer, but it is sent right away. The
+  // columns of all pages are contiguous, so they can be sent as one window in the background instead, which is done,
+  // if it isn't more data, e.g. for a new screen
+  uint16_t blocks = 0;
+  int page_bytes = 0;
+  for (auto page_blocks : changed) {
+    blocks |= page_blocks;
+    if (page_blocks) {
+      page_bytes += (32 - __builtin_clz(page_blocks) - __builtin_ctz(page_blocks)) * block_width;
+    }
+  }
+  if (not blocks) {
+    sent_valid_ |= pages_mask;
+    return;
+  }
+  const uint8_t first = __builtin_ctz(blocks) * block_width;
+  const uint8_t last = (32 - __builtin_clz(blocks)) * block_width - 1;
+
+  memcpy(front_[first].data(), canvas_[first].data(), (last - first + 1) * canvas_[0].size());
+  bool ok;
+  if (page_bytes < (last - first + 1) * pages) {
+    ok = display_->draw_canvas(front_, changed);
+  } else {
+    flushing_ = display_->start_canvas(front_, first, last);
+    ok = flushing_;
+  }
+#else
+  const bool ok = display_->draw_canvas(canvas_, changed, first_page_);
+#endif
 
-  if (ssd_1306_) {
-    ssd_1306_->draw_canvas(canvas_);
+  if (ok) {
+    sent_valid_ |= pages_mask;
+  } else {
+    // the display RAM is unknown now
+    invalidate();
   }
 }
 
+void GFX::invalidate() {
+  written_.fill(UINT16_MAX);
+  sent_valid_ = 0;
+}
+
+
+bool GFX::begin_transition() {
+#ifdef GFX_DOUBLE_BUFFER
+  // the start line wraps around the 64 rows of the RAM, so shorter panels would show rows that aren't on the canvas
+  if (not display_ || transition_ || height != 64) {
+    return false;
+  }
+  if (flushing_) {
+    flushing_ = false;
+    if (not display_->wait_canvas()) {
+      invalidate();
+    }
+  }
+
+  // the display has to show the canvas, which becomes the last frame
+  const bool all_sent = std::all_of(written_.begin(), written_.end(), [](uint16_t w) { return w == 0; });
+  if (sent_valid_ != UINT8_MAX || not all_sent) {
+    return false;
+  }
+  front_ = canvas_;
+  transition_ = true;
+  new_pages_ = 0;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void GFX::transition_step(uint8_t rows) {
+#ifdef GFX_DOUBLE_BUFFER
+  if (not transition_) {
+    return;
+  }
+  rows = std::min(rows, height);
+
+  // rows 0 to rows - 1 of the canvas are shown at the bottom of the display. The page with the last of them is a mix
+  // of both frames, the pages above it are sent once, when they are done
+  bool ok = true;
+  for (int row = 8 * new_pages_; ok && row < rows; row += 8) {
+    const uint8_t page = page_of(row);
+    const int new_rows = std::min(rows - row, 8);
+    ok = display_->draw_page(canvas_, front_, page, 0xFF << (8 - new_rows));
+    if (ok && new_rows == 8) {
+      // as if sent by draw(), later writes are sent by the next draw(). The last frame in this page isn't needed
+      // anymore, so the front buffer takes what the display shows
+      for (uint8_t block = 0; block < num_blocks; ++block) {
+        sent_[page][block] = block_signature(page, block);
+      }
+      for (int x = 0; x < width; ++x) {
+        front_[x][page] = canvas_[x][page];
+      }
+      written_[page] = 0;
+      ++new_pages_;
+    }
+  }
+
+  // display row r shows canvas row (r - start line) % 64
+  ok = ok && display_->set_start_line(height - rows);
+  if (not ok) {
+    // the display RAM is unknown, the next draw() sends everything
+    transition_ = false;
+    display_->set_start_line(0);
+    invalidate();
+  }
+#else
+  (void)rows;
+#endif
+}
+
+void GFX::end_transition() {
+#ifdef GFX_DOUBLE_BUFFER
+  transition_step(height);
+  transition_ = false;
+#endif
+}
+
+
+void GFX::first_page() {
+  first_page_ = 0;
+  if constexpr (buffer_pages < pages) {
+    clear_canvas();
+  }
+}
+
+bool GFX::next_page() {
+  draw();
+  if constexpr (buffer_pages == pages) {
+    return false;
+  }
+
+  first_page_ += buffer_pages;
+  if (first_page_ >= pages) {
+    first_page_ = 0;
+    return false;
+  }
+  clear_canvas();
+  return true;
+}
+
 
 void GFX::clear_canvas() {
   // we can use memset instead of a double for
-  memset(canvas_.data(), 0, 128 * 8);
+  memset(canvas_.data(), 0, sizeof(canvas_));
+  written_.fill(UINT16_MAX);
   move_cursor({ 0, 0 });
 }
 
 
 
-void GFX::draw_circle(const Pixel& pix, uint8_t radius, bool val) {
-  // create a slightly larger box around the circle
-  static constexpr uint8_t margin = 2;
-  const Pixel start{ static_cast<uint8_t>(std::max(0, pix.x_ - radius - margin)),
-                     static_cast<uint8_t>(std::max(0, pix.y_ - radius - margin)) },
-      end{ static_cast<uint8_t>(std::min(127, pix.x_ + radius + margin)),
-           static_cast<uint8_t>(std::min(63, pix.y_ + radius + margin)) };
+void GFX::set_viewport(const Pixel& top_left, const Pixel& bottom_right) {
+  viewport_ = { top_left.x_, top_left.y_, bottom_right.x_, bottom_right.y_ };
+  set_clip({ 0, 0 }, { bottom_right.x_ - top_left.x_, bottom_right.y_ - top_left.y_ });
+}
 
-  // check each pixel in the bo, if it is inside the circle
-  // not the most efficient way
+void GFX::set_clip(const Pixel& top_left, const Pixel& bottom_right) {
+  const Pixel tl = to_display(top_left);
+  const Pixel br = to_display(bottom_right);
+  // within the viewport, which may be partly off the display
+  clip_.x0 = std::max({ tl.x_, viewport_.x0, 0 });
+  clip_.y0 = std::max({ tl.y_, viewport_.y0, 0 });
+  clip_.x1 = std::min({ br.x_, viewport_.x1, width - 1 });
+  clip_.y1 = std::min({ br.y_, viewport_.y1, height - 1 });
+  clip_rows_ = row_mask(clip_.y0, clip_.y1);
+}
 
-  auto callback = [&pix, radius, val, this](const Pixel& curr) {
-    if (pix.distance(curr) <= radius) {
-      this->set_pixel(curr, val);
+void GFX::clear_viewport() {
+  for (int x = clip_.x0; x <= clip_.x1; ++x) {
+    fill_column(x, clip_.y0, clip_.y1, false);
+  }
+}
+
+
+void GFX::plot(int x, int y, bool val) {
+  if (not in_clip(x, y)) {
+    return;
+  }
+  auto [page, mask] = get_page_and_mask(y);
+  auto& byte = canvas_write(x, page);
+  if (val) {
+    byte |= mask;
+  } else {
+    byte &= ~mask;
+  }
+}
+
+void GFX::fill_column(int x, int y0, int y1, bool val) {
+  if (x < clip_.x0 || x > clip_.x1) {
+    return;
+  }
+  y0 = std::max(y0, clip_.y0);
+  y1 = std::min(y1, clip_.y1);
+
+  // one byte per page, row 0 is the MSB of the last page
+  for (int y = y0; y <= y1;) {
+    const int end = std::min(y | 7, y1);
+    const uint8_t mask = (0xFF >> (y & 7)) & (0xFF << (7 - (end & 7)));
+    auto& byte = canvas_write(x, page_of(y));
+    if (val) {
+      byte |= mask;
+    } else {
+      byte &= ~mask;
     }
-  };
+    y = end + 1;
+  }
+}
+
 
-  pixel_iterate(start, end, callback);
+void GFX::draw_circle(const Pixel& center, uint8_t radius, bool val) {
+  const Pixel pix = to_display(center);
+  // for each column, the half height shrinks while moving away from the center
+  const int r2 = radius * radius;
+  int dy = radius;
+  for (int dx = 0; dx <= radius; ++dx) {
+    while (dx * dx + dy * dy > r2) {
+      --dy;
+    }
+    fill_column(pix.x_ - dx, pix.y_ - dy, pix.y_ + dy, val);
+    if (dx) {
+      fill_column(pix.x_ + dx, pix.y_ - dy, pix.y_ + dy, val);
+    }
+  }
+}
+
+void GFX::draw_circle_outline(const Pixel& center, uint8_t radius, bool val) {
+  const Pixel pix = to_display(center);
+  int x = radius;
+  int y = 0;
+  int err = 1 - x;
+  while (x >= y) {
+    // all 8 octants
+    plot(pix.x_ + x, pix.y_ + y, val);
+    plot(pix.x_ - x, pix.y_ + y, val);
+    plot(pix.x_ + x, pix.y_ - y, val);
+    plot(pix.x_ - x, pix.y_ - y, val);
+    plot(pix.x_ + y, pix.y_ + x, val);
+    plot(pix.x_ - y, pix.y_ + x, val);
+    plot(pix.x_ + y, pix.y_ - x, val);
+    plot(pix.x_ - y, pix.y_ - x, val);
+
+    ++y;
+    if (err < 0) {
+      err += 2 * y + 1;
+    } else {
+      --x;
+      err += 2 * (y - x) + 1;
+    }
+  }
 }
 
 
 void GFX::draw_rectangle(const Pixel& top_left, const Pixel& bottom_right, bool val) {
-  auto callback = [this, val](const Pixel& curr) { this->set_pixel(curr, val); };
+  const Pixel tl = to_display(top_left);
+  const Pixel br = to_display(bottom_right);
+  for (int x = std::max(tl.x_, clip_.x0); x <= std::min(br.x_, clip_.x1); ++x) {
+    fill_column(x, tl.y_, br.y_, val);
+  }
+}
+
+void GFX::draw_line(const Pixel& line_from, const Pixel& line_to, bool val) {
+  const Pixel from = to_display(line_from);
+  const Pixel to = to_display(line_to);
+  if (from.x_ == to.x_) {
+    fill_column(from.x_, std::min(from.y_, to.y_), std::max(from.y_, to.y_), val);
+    return;
+  }
+
+  const int dx = std::abs(to.x_ - from.x_);
+  const int dy = -std::abs(to.y_ - from.y_);
+  const int step_x = from.x_ < to.x_ ? 1 : -1;
+  const int step_y = from.y_ < to.y_ ? 1 : -1;
+  int err = dx + dy;
+  int x = from.x_, y = from.y_;
+  while (true) {
+    plot(x, y, val);
+    if (x == to.x_ && y == to.y_) {
+      break;
+    }
+    const int e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x += step_x;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y += step_y;
+    }
+  }
+}
 
-  pixel_iterate(top_left, bottom_right, callback);
+void GFX::render_glyph(const Pixel& pos, char32_t c) {
+  draw_char({ pos.x_, 8 * pos.y_ }, c);
 }
 
-/// \todo rework this mess
-void GFX::render_glyph(const Pixel& pos, char c) {
-  const auto x_offset = pos.x_;
-  const auto page = 7 - utils::constrain(pos.y_, 0, 7);
-  const auto& curr_font = fonts::font1;
 
-  if (c < curr_font.offset_) {
+uint8_t GFX::draw_char(const Pixel& glyph_top_left, char32_t c) {
+  const auto& font = *font_;
+  // a single lookup, characters outside of the dense range of the font are a binary search
+  const int index = font.index_of(c);
+  if (index < 0) {
     // cant render
-    return;
+    return 0;
   }
-  const auto index = c - curr_font.offset_;
-  if (index >= curr_font.num_glyphs_) {
-    // cant render
-    return;
+  const uint8_t* glyph = font.glyph_at(index);
+  const uint8_t glyph_width = font.width_at(index);
+  const uint8_t advance = glyph_width + font.spacing_;
+  const Pixel top_left = to_display(glyph_top_left);
+  if (top_left.y_ + font.height() <= clip_.y0 || top_left.y_ > clip_.y1) {
+    return advance;
   }
 
-  /*
-   * we can only set columns in the canvas, not rows
-   * so we need to extract columns from the bitmap
-   * bitmap data is in binary, in the format:
-   * u8, u8, u8
-   * u8, u8, u8
-   * with 8 rows
-   */
-  for (int col = 7; col >= 0; --col) {
-    // construct columns in reverse to display correctly
-    uint8_t column_val{ 0 };
+  // the glyph columns are already in the page format, top page first, top row in the MSB. Rows outside of the clip
+  // rectangle are masked
+  const int font_pages = font.pages_;
+  const int x_begin = std::max(top_left.x_, clip_.x0);
+  const int x_end = std::min(top_left.x_ + glyph_width, clip_.x1 + 1);
+  const int shift = top_left.y_ & 7;
+  const int page = page_of(top_left.y_);  // page of the top row, floor division for negative y
+
+  if (shift == 0) {
+    // aligned: plain copy of the columns
+    const int first = std::max(page - (pages - 1), 0);
+    const int last = std::min(page, font_pages - 1);
+    for (int x = x_begin; x < x_end; ++x) {
+      const uint8_t* col = glyph + (x - top_left.x_) * font_pages;
+      for (int i = first; i <= last; ++i) {
+        const uint8_t clip = clip_mask(page - i);
+        if (clip) {
+          auto& byte = canvas_write(x, page - i);
+          byte = (byte & ~clip) | (col[i] & clip);
+        }
+      }
+    }
+    return advance;
+  }
 
-    for (int glyph_row = 0; glyph_row < 8; ++glyph_row) {
-      // get the index for the row of this char
-      auto ind = index + glyph_row * curr_font.num_glyphs_;
-      auto a = curr_font.font_[ind];
-      // extract the bit, and place it into the row
-      column_val |= (!!(a & (uint8_t)(1 << col))) << (7 - glyph_row);
+  // unaligned: the top part of each byte goes into the lower bits of its page, the rest into the upper bits of the
+  // page below
+  const uint8_t upper_mask = 0xff >> shift;
+  const uint8_t lower_mask = ~upper_mask;
+  for (int x = x_begin; x < x_end; ++x) {
+    const uint8_t* col = glyph + (x - top_left.x_) * font_pages;
+    for (int i = 0; i < font_pages; ++i) {
+      const int p = page - i;
+      if (p >= 0 && p < pages) {
+        const uint8_t mask = upper_mask & clip_mask(p);
+        if (mask) {
+          auto& byte = canvas_write(x, p);
+          byte = (byte & ~mask) | ((col[i] >> shift) & mask);
+        }
+      }
+      if (p >= 1 && p <= pages) {
+        const uint8_t mask = lower_mask & clip_mask(p - 1);
+        if (mask) {
+          auto& byte = canvas_write(x, p - 1);
+          byte = (byte & ~mask) | (static_cast<uint8_t>(col[i] << (8 - shift)) & mask);
+        }
+      }
     }
-    // finally write the column
-    canvas_access(7 - col + x_offset, page) = column_val;
   }
+  return advance;
 }
 
 
-void GFX::draw_text(const char* txt) {
-  const auto len = strlen(txt);
-  const auto increment = fonts::font1.width;
+void GFX::set_font(const fonts::Font_t& font) {
+  font_ = &font;
+}
 
+
+void GFX::draw_text(const char* txt) {
   bool state{ true };
 
-  for (unsigned int i = 0; i < len; ++i) {
+  while (*txt) {
     if (!state) {
       return;
     }
-    render_one(txt[i], increment, state);
+    render_one(utf8::next(txt), state);
   }
 }
 
 
-void GFX::render_one(char c, uint8_t increment, bool& state) {
+void GFX::render_one(char32_t c, bool& state) {
   if (!state) {
     return;
   }
+  const auto& font = *font_;
 
   switch (c) {
     case '\r':
@@ -161,26 +524,27 @@ void GFX::render_one(char c, uint8_t increment, bool& state) {
       return;
     case '\n':
       cursor_.x_ = 0;
-      cursor_.y_++;
-      if (cursor_.y_ > 7) {
+      cursor_.y_ += font.pages_;
+      if (cursor_.y_ + font.pages_ > viewport_lines()) {
         cursor_.y_ = 0;
         return;
       }
       return;
     case '\t':
       // render tab as 2 spaces
-      render_one(' ', increment, state);
-      render_one(' ', increment, state);
+      render_one(' ', state);
+      render_one(' ', state);
       return;
   }
 
-  render_glyph(cursor_, c);
-  cursor_.x_ += increment;
-  if (cursor_.x_ > 127 - increment) {
+  const uint8_t advance = draw_char({ cursor_.x_, 8 * cursor_.y_ }, c);
+  // characters missing in the font are skipped like a space
+  cursor_.x_ += advance ? advance : font.width + font.spacing_;
+  if (cursor_.x_ > viewport_.x1 - viewport_.x0 - font.width) {
     // next char won't fit
     cursor_.x_ = 0;
-    cursor_.y_++;
-    if (cursor_.y_ > 7) {
+    cursor_.y_ += font.pages_;
+    if (cursor_.y_ + font.pages_ > viewport_lines()) {
       // screen is full
       cursor_.y_ = 0;
       state = false;
@@ -196,6 +560,7 @@ void GFX::move_cursor(const Pixel& to) {
 void GFX::printf(const char* fmt, ...) {
   std::va_list args;
   va_start(args, fmt);
+  decoder_ = {};
   npf_vpprintf(putc, this, fmt, args);
   va_end(args);
 }
@@ -203,6 +568,9 @@ void GFX::printf(const char* fmt, ...) {
 
 void GFX::putc(int c, void* ptr) {
   GFX& gfx = *reinterpret_cast<GFX*>(ptr);
-  bool b = true;
-  gfx.render_one(c, 8, b);
+  // the characters arrive byte by byte
+  if (gfx.decoder_.feed(static_cast<char>(c))) {
+    bool b = true;
+    gfx.render_one(gfx.decoder_.codepoint(), b);
+  }
 }
@@ -7,13 +7,19 @@
  */
 
 #include <cstdint>
+#include <cstddef>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cstdarg>
 #include <cmath>
 
-class SSD1306;
+#include "SSD1306/fonts.h"
+#include "utf8.h"
+#include "SSD1306/canvas.h"
+#include "SSD1306/image.h"
+#include "display_driver.h"
 
 /// Represents a pixel on the display
 struct Pixel {
@@ -32,12 +38,54 @@ struct Pixel {
   }
 };
 
-/// Graphics driver for the SSD1306
+/**
+ * @brief Graphics driver for the panel of Display, see display_driver.h
+ * @details The geometry is the one of Display, the drawing code is the same for every panel. Writes to the canvas are
+ * tracked in blocks of 8 columns of one page, and draw() sends the written blocks to the display.
+ *
+ * If GFX_DOUBLE_BUFFER is defined, the changed columns are copied into a front buffer on draw(). A large change is sent
+ * from it in the background, while the next frame is drawn, and draw() only waits, if the previous frame is still being
+ * sent. A small one, like a clock tick, is sent as a window per changed page, which is far less data. The front buffer
+ * holds what the display shows, so written blocks which are still the same aren't sent: a signature of the block last
+ * sent finds the changed ones quickly, and an equal signature is confirmed byte by byte. A screen redrawn from scratch
+ * every frame thus only sends the few blocks, which differ from the previous frame.
+ *
+ * If GFX_PAGE_BUFFER is defined to 1, 2 or 4, the canvas only holds that many pages(a strip), instead of the whole
+ * display. A frame is then drawn strip by strip, by running the same drawing code for each strip:
+ * @code
+ * gfx.first_page();
+ * do {
+ *   // draw the whole frame, only the part inside the strip is stored
+ * } while (gfx.next_page());
+ * @endcode
+ * The same loop works without GFX_PAGE_BUFFER, the body is then run once.
+ */
 class GFX {
 public:
-  using canvas_t = std::array<std::array<uint8_t, 8>, 128>;  ///< canvas, where each bit is one pixel
+  static constexpr uint8_t width = Display::width;    ///< Columns of the display
+  static constexpr uint8_t height = Display::height;  ///< Rows of the display
+  static constexpr uint8_t pages = Display::pages;    ///< Pages of the display
+  static_assert(width == 128 && height <= 64 && height % 8 == 0, "a column has to fit into 64 bits");
+
+#if defined(GFX_PAGE_BUFFER)
+  static constexpr uint8_t buffer_pages = GFX_PAGE_BUFFER;  ///< Pages held in the canvas
+#else
+  static constexpr uint8_t buffer_pages = pages;  ///< Pages held in the canvas
+#endif
+  static_assert(buffer_pages && pages % buffer_pages == 0, "GFX_PAGE_BUFFER must divide the pages of the display");
+#if defined(GFX_PAGE_BUFFER) && defined(GFX_DOUBLE_BUFFER)
+#error "GFX_PAGE_BUFFER and GFX_DOUBLE_BUFFER can't be used together"
+#endif
 
-  GFX(SSD1306* ssd) : ssd_1306_(ssd) {
+  using canvas_t = canvas::canvas_t<buffer_pages>;  ///< canvas, where each bit is one pixel
+
+  static constexpr uint8_t block_width = canvas::block_width;  ///< Columns in one block of dirty tracking
+  static constexpr uint8_t num_blocks = canvas::num_blocks;    ///< Blocks in one page
+
+  /// Bit b of element p is set, if block b (columns 8b to 8b+7) of page p of the canvas is dirty
+  using dirty_t = canvas::dirty_t<buffer_pages>;
+
+  GFX(Display* display) : display_(display) {
   }
 
   void set_pixel(const Pixel& pix, bool val = true);
@@ -45,43 +93,257 @@ public:
   bool get_pixel(const Pixel& pix);
   void toggle_pixel(const Pixel& pix);
 
+  /// @brief Clears the whole canvas, regardless of the viewport
   void clear_canvas();
 
+  /// @name Viewport
+  /// @details All drawing is relative to the top left corner of the viewport, and is clipped to the clip rectangle,
+  /// which is the viewport unless set_clip() made it smaller. A panel, e.g. a status bar, can thus be drawn with the
+  /// same code anywhere on the display, without touching anything outside of it:
+  /// @code
+  /// gfx.set_viewport({ 0, 56 }, { 127, 63 });
+  /// gfx.clear_viewport();
+  /// gfx.draw_text_aligned({ 0, 0 }, 128, GFX::Align::RIGHT, "12:00");
+  /// gfx.reset_viewport();
+  /// @endcode
+  /// Primitives clip once per call(or once per span or glyph), and then write the canvas without further checks.
+  /// Reading, e.g. get_pixel() and the source of blit(), is translated but not clipped, pixels outside of the display
+  /// read as 0. Text line n starts 8 * n rows below the top of the viewport, and text wraps at its right edge.
+  /// @{
+  /// @brief Moves the origin to @p top_left, and clips to the rectangle to @p bottom_right, both in display coordinates
+  void set_viewport(const Pixel& top_left, const Pixel& bottom_right);
+
+  /// @brief The whole display
+  void reset_viewport() {
+    set_viewport({ 0, 0 }, { width - 1, height - 1 });
+  }
+
+  /// @brief Clips to the rectangle from @p top_left to @p bottom_right within the viewport, in viewport coordinates
+  void set_clip(const Pixel& top_left, const Pixel& bottom_right);
+
+  /// @brief Clears the clip rectangle
+  void clear_viewport();
+  /// @}
+
+  /// @name Shapes
+  /// @details Shapes are clipped to the clip rectangle. Filled shapes are drawn as vertical spans, which cover whole
+  /// bytes of the canvas, so each byte is only written once per span.
+  /// @{
+  /// @brief Filled circle with center @p pix, all pixels within @p radius are set to @p val
   void draw_circle(const Pixel& pix, uint8_t radius, bool val = true);
 
+  /// @brief Circle outline with center @p pix, using the midpoint algorithm
+  void draw_circle_outline(const Pixel& pix, uint8_t radius, bool val = true);
+
+  /// @brief Filled rectangle, the corners are included
   void draw_rectangle(const Pixel& top_left, const Pixel& bottom_right, bool val = true);
 
+  /// @brief Line from @p from to @p to, both included, using the Bresenham algorithm
+  void draw_line(const Pixel& from, const Pixel& to, bool val = true);
+  /// @}
+
+  /// @brief Raster operations of the blitter, the result is stored in the destination
+  enum class RasterOp : uint8_t {
+    COPY,  ///< dst = src
+    OR,    ///< dst = dst | src
+    AND,   ///< dst = dst & src
+    XOR,   ///< dst = dst ^ src
+    NOT,   ///< dst = ~src
+  };
+
+  /// @name Blitter
+  /// @details The blitter works on whole columns, a column of the canvas is up to 64 pixels or two 32-bit words, with
+  /// the top row in the MSB. Rows are moved by shifting the column, and masked into the destination, so no single
+  /// pixels are touched. Source and destination are clipped to the display, pixels outside of it read as 0. In page
+  /// streaming mode, only the pages of the current strip can be read.
+  /// @{
+  /// @brief Combine the rectangle from @p src_top_left to @p src_bottom_right with the one at @p dst_top_left
+  /// @details The rectangles can overlap, e.g. for scrolling.
+  void blit(const Pixel& src_top_left, const Pixel& src_bottom_right, const Pixel& dst_top_left,
+            RasterOp op = RasterOp::COPY);
+
+  /**
+   * @brief Combine the @p width x @p height @p bitmap with the canvas at @p dst_top_left
+   * @details The bitmap is stored by columns, each column is (height + 7) / 8 bytes, the top row of each byte is the
+   * MSB. Heights up to 64 are supported.
+   */
+  void blit_bitmap(const uint8_t* bitmap, uint8_t width, uint8_t height, const Pixel& dst_top_left,
+                   RasterOp op = RasterOp::COPY);
+
+  /**
+   * @brief Combine the compressed @p image with the canvas at @p dst_top_left, see image.h
+   * @details The image is decoded band by band straight into the pages of the canvas, without a buffer. In page
+   * streaming mode only the bands on the current strip are decoded, so the image goes to the display strip by strip.
+   */
+  void draw_image(const images::Image_t& image, const Pixel& dst_top_left, RasterOp op = RasterOp::COPY);
+
+  /// @brief Invert all pixels of the rectangle, e.g. for highlighting
+  void invert_rect(const Pixel& top_left, const Pixel& bottom_right);
+
+  /// @brief Move the content of the rectangle by @p dx, @p dy pixels, the uncovered part is cleared
+  void scroll(const Pixel& top_left, const Pixel& bottom_right, int dx, int dy);
+  /// @}
+
   /**
    * @brief Draws the character to the canvas
    *
    * @param pos x is the x pos, y is the page/line(0-7)
-   * @param c the char to render (0-127)
+   * @param c the codepoint to render
    */
-  void render_glyph(const Pixel& pos, char c);
+  void render_glyph(const Pixel& pos, char32_t c);
+
+  /**
+   * @brief Draws the character in the current font with its top left corner at any pixel, clipped to the display
+   * @details On a page boundary every byte of a column is a single copy, otherwise each byte is split over two pages.
+   * @return how far the cursor should move, 0 if the font doesn't contain @p c
+   */
+  uint8_t draw_char(const Pixel& top_left, char32_t c);
+
+  /// @brief Font used for the following text, the cursor moves by its glyph widths and height
+  void set_font(const fonts::Font_t& font);
+
+  /// @brief Current font, e.g. for measuring text
+  const fonts::Font_t& font() const {
+    return *font_;
+  }
 
   /**
    * @brief Draws text to the current cursor_ pos
    *
-   * @param txt
+   * @param txt UTF-8 text, characters missing in the font are skipped like a space
    */
   void draw_text(const char* txt);
 
   void move_cursor(const Pixel& to);
 
+  /// Position of the next character, x in pixels, y in lines
+  const Pixel& cursor() const {
+    return cursor_;
+  }
+
   /// Draw printf-style text to display
   void printf(const char* fmt, ...);
 
-  /// Transfer the buffer onto the display
+  /// @brief Horizontal alignment of text in a box
+  enum class Align : uint8_t {
+    LEFT,
+    CENTER,
+    RIGHT,
+  };
+
+  /// @name Text layout
+  /// @details Text is placed in a box starting at a pixel column and a line, and is measured in the current font like
+  /// draw_text() moves the cursor. The cursor isn't used or moved. Formatted text is printed once into a stack buffer
+  /// of text_buffer_size bytes, which is then measured and drawn.
+  /// @{
+  static constexpr uint8_t text_buffer_size = 32;  ///< Longest formatted text, including the terminating 0
+
+  /// @brief Width of @p txt in pixels, which is drawn on a single line
+  int text_width(const char* txt) const {
+    return font_->text_width(txt);
+  }
+
+  /**
+   * @brief Draws @p txt on a single line, aligned in the box of @p width pixels at @p pos
+   * @details Text wider than the box is truncated, and ends with "..." if there is space for it.
+   * @param pos x is the first column of the box, y the line(page)
+   * @return width of the drawn text in pixels
+   */
+  int draw_text_aligned(const Pixel& pos, int width, Align align, const char* txt);
+
+  /// @brief printf-style draw_text_aligned()
+  int printf_aligned(const Pixel& pos, int width, Align align, const char* fmt, ...);
+
+  /**
+   * @brief Draws @p txt wrapped at spaces into lines of @p width pixels, the first one at @p pos
+   * @details '\n' starts a new line, words wider than a line are broken. If the text needs more than @p max_lines, the
+   * last line is truncated like draw_text_aligned().
+   * @return number of lines drawn
+   */
+  uint8_t draw_text_wrapped(const Pixel& pos, int width, uint8_t max_lines, const char* txt, Align align = Align::LEFT);
+  /// @}
+
+  /// Transfer the changed parts of the buffer onto the display
   void draw();
 
+  /// Transfer the whole buffer on the next draw(), e.g. if the display RAM was changed externally
+  void invalidate();
+
+  /// @name Transitions
+  /// @details The next frame pushes the last one up, using the start line of the display: the whole picture is moved
+  /// by one command, and only the rows moving onto the display are sent, page by page. The last frame is kept in the
+  /// front buffer, so this needs GFX_DOUBLE_BUFFER and a panel of 64 rows. Otherwise begin_transition() fails, and the
+  /// next frame is just drawn. The frames of the transition are drawn into the canvas as usual, but shown with transition_step() instead
+  /// of draw():
+  /// @code
+  /// gfx.begin_transition();
+  /// // for each frame, rows going from 0 to 64
+  /// gfx.first_page();
+  /// screen.draw();
+  /// gfx.transition_step(rows);
+  /// // done
+  /// gfx.end_transition();
+  /// @endcode
+  /// @{
+  /// @brief Start a transition from the frame on the display. @return false, if transitions aren't possible
+  bool begin_transition();
+
+  /// @brief Show the last frame moved up by @p rows(0 to 64), and the top @p rows of the canvas below it
+  void transition_step(uint8_t rows);
+
+  /// @brief Show the whole canvas, and continue with draw(), which also ends a running transition
+  void end_transition();
+
+  /// @return true between begin_transition() and end_transition()
+  bool in_transition() const {
+#ifdef GFX_DOUBLE_BUFFER
+    return transition_;
+#else
+    return false;
+#endif
+  }
+  /// @}
+
+  /// @name Page streaming
+  /// @brief Loop for drawing a frame strip by strip, see GFX
+  /// @{
+  /// @brief Start a frame with the first strip, the strip is cleared
+  void first_page();
+  /// @brief Send the strip to the display, and go to the next one. @return false, if the frame is done
+  bool next_page();
+  /// @}
+
   /// Used by nanoprintf to render characters. @p p must point to and instance of GFX / this
   static void putc(int c, void* p);
 
 private:
-  canvas_t canvas_{ 0 };  ///< drawing canvas
-  Pixel cursor_;          ///< cursor for text drawing
+  /// Rectangle on the display, both corners are included. Empty if x0 > x1 or y0 > y1
+  struct Rect {
+    int x0, y0, x1, y1;
+  };
+
+  alignas(4) canvas_t canvas_{ 0 };             ///< drawing canvas, aligned for word access of the blitter
+  uint8_t first_page_{ 0 };                     ///< Page of the display in the first page of the canvas
+  uint8_t outside_{ 0 };                        ///< Target of accesses outside of the canvas
+  Pixel cursor_;                                ///< cursor for text drawing
+  const fonts::Font_t* font_{ &fonts::font1 };  ///< font for text drawing
+  utf8::Decoder decoder_;                       ///< Characters of printf(), which come byte by byte
+
+  Rect viewport_{ 0, 0, width - 1, height - 1 };   ///< Viewport in display coordinates, its top left is the origin
+  Rect clip_{ 0, 0, width - 1, height - 1 };       ///< Clip rectangle in display coordinates, always on the display
+  uint64_t clip_rows_{ row_mask(0, height - 1) };  ///< Rows of clip_ as a column, row r is bit 63 - r
+
+  dirty_t written_{};         ///< Blocks written since the last draw()
+  uint8_t sent_valid_{ 0 };   ///< Bit p is set, if page p of the display shows what was sent
+#ifdef GFX_DOUBLE_BUFFER
+  std::array<std::array<uint16_t, num_blocks>, pages> sent_{};  ///< Signatures of the blocks last sent, for each page
+  canvas_t front_{ 0 };       ///< Copy of the canvas being sent to the display
+  bool flushing_{ false };    ///< front_ is being sent
+  bool transition_{ false };  ///< Between begin_transition() and end_transition(), front_ holds the last frame
+  uint8_t new_pages_{ 0 };    ///< Pages of the transition already sent from the canvas, from the top
+#endif
 
-  SSD1306* const ssd_1306_{ nullptr };
+  Display* const display_{ nullptr };
 
   /**
    * @brief For a given row, returns the page number and bit mask
@@ -92,40 +354,90 @@ private:
   std::pair<uint8_t, uint8_t> get_page_and_mask(uint8_t row) const;
 
   /**
-   * @brief Bound checks and returns reference to byte in canvas_
+   * @brief Returns reference to byte in canvas_, the caller has to clip to the display
+   * @details If page @p j isn't in the canvas, a dummy byte is returned, which reads as 0
    *
-   * @param i index 1
-   * @param j index 2
+   * @param i column
+   * @param j page of the display
    * @return uint8_t&
    */
   uint8_t& canvas_access(uint8_t i, uint8_t j);
 
+  /// @brief Same as canvas_access(), but marks the byte as written, to be used when the canvas is modified
+  uint8_t& canvas_write(uint8_t i, uint8_t j);
 
-  /**
-   * @brief Iterates through pixels from \p from to \p to
-   * @details IMPORTANT: \p from should be LESS than \p to
-   *
-   * @tparam LAMBDA type of lambda, this allows the lambda to have a capture list
-   * @param from
-   * @param to
-   * @param callback callback, can be a simple function pointer or a lambda
-   */
-  template <class LAMBDA>
-  void pixel_iterate(const Pixel& from, const Pixel& to, LAMBDA& callback) {
-    for (Pixel curr{ from }; curr.x_ <= to.x_; ++curr.x_) {
-      for (curr.y_ = from.y_; curr.y_ <= to.y_; ++curr.y_) {
-        callback(curr);
-      }
+  /// @return @p pix of the viewport in display coordinates
+  Pixel to_display(const Pixel& pix) const {
+    return { pix.x_ + viewport_.x0, pix.y_ + viewport_.y0 };
+  }
+
+  /// @return number of text lines in the viewport
+  int viewport_lines() const {
+    return (viewport_.y1 - viewport_.y0 + 1) / 8;
+  }
+
+  /// @return true, if pixel @p x, @p y of the display is inside of the clip rectangle
+  bool in_clip(int x, int y) const {
+    return x >= clip_.x0 && x <= clip_.x1 && y >= clip_.y0 && y <= clip_.y1;
+  }
+
+  /// @return rows of the clip rectangle in page @p page of the display
+  uint8_t clip_mask(int page) const {
+    return clip_rows_ >> (8 * page + column_shift);
+  }
+
+  /// Bits of a column below the bottom row of the display, so row r is always bit 63 - r
+  static constexpr uint8_t column_shift = 64 - height;
+
+  /// @return page of the display with row @p y, the top row is in the last page
+  static constexpr int page_of(int y) {
+    return pages - 1 - (y >> 3);
+  }
+
+  /// @brief Mask of rows @p y0 to @p y1 in a column, clipped to the display
+  static constexpr uint64_t row_mask(int y0, int y1) {
+    y0 = std::max(y0, 0);
+    y1 = std::min<int>(y1, height - 1);
+    if (y0 > y1) {
+      return 0;
     }
+    // row r is bit 63 - r
+    return (UINT64_MAX >> y0) & (UINT64_MAX << (63 - y1));
   }
 
+#ifdef GFX_DOUBLE_BUFFER
+  /// @brief Signature of block @p block of page @p page of the canvas
+  uint16_t block_signature(uint8_t page, uint8_t block) const;
+
+  /// @return true, if block @p block of page @p page of the canvas is the same as in the front buffer
+  bool same_as_front(uint8_t page, uint8_t block) const;
+#endif
+
+
+  /// @brief Column @p x of the display, row r is bit 63 - r. Pixels outside of the canvas are 0
+  uint64_t load_column(int x) const;
+
+  /// @brief Sets the bits in @p mask of column @p x of the display to @p val, clipped
+  void store_column(int x, uint64_t val, uint64_t mask);
+
+  /// @brief Sets pixel @p x, @p y of the display to @p val, clipped
+  void plot(int x, int y, bool val);
+
+  /// @brief Sets rows @p y0 to @p y1 of column @p x of the display to @p val, clipped
+  void fill_column(int x, int y0, int y1, bool val);
+
   /**
    * @brief Render one character and advances the cursor
    * @details success is not returned, but modified in a parameter, so code which
    * uses this method will be shorter, no need to wrap it in if, just call with the same \p state parameter
    * @param c char to render
-   * @param increment width of the char
    * @param state only render if true, method will set this to false if end of screen is reached
    */
-  void render_one(char c, uint8_t increment, bool& state);
+  void render_one(char32_t c, bool& state);
+
+  /// @brief Bytes of the characters at the start of the first @p len bytes of @p txt, which fit into @p width pixels
+  std::size_t fit(const char* txt, std::size_t len, int width) const;
+
+  /// @brief Draws the first @p len bytes of @p txt on one line, see draw_text_aligned()
+  int draw_line(const Pixel& pos, int width, Align align, const char* txt, std::size_t len);
 };
@@ -0,0 +1,198 @@
+/**
+ * @file GFX_blit.cpp
+ * @brief Blitter of the GFX class
+ *
+ */
+
+#include "GFX.h"
+
+#include <cstring>
+#include <algorithm>
+#include "utils.h"
+
+
+/// Column moved down by @p rows, or up if negative
+static uint64_t shift_rows(uint64_t col, int rows) {
+  if (rows >= 64 || rows <= -64) {
+    return 0;
+  }
+  return rows >= 0 ? col >> rows : col << -rows;
+}
+
+static uint64_t apply(GFX::RasterOp op, uint64_t dst, uint64_t src) {
+  switch (op) {
+    case GFX::RasterOp::COPY:
+      return src;
+    case GFX::RasterOp::OR:
+      return dst | src;
+    case GFX::RasterOp::AND:
+      return dst & src;
+    case GFX::RasterOp::XOR:
+      return dst ^ src;
+    case GFX::RasterOp::NOT:
+      return ~src;
+  }
+  return dst;
+}
+
+
+uint64_t GFX::load_column(int x) const {
+  if (not utils::within(x, 0, width - 1)) {
+    return 0;
+  }
+
+  // byte p of the column is page p, so the little endian column has the top row in the MSB
+  uint64_t col = 0;
+  if constexpr (buffer_pages == 8 && height == 64) {
+    memcpy(&col, canvas_[x].data(), sizeof(col));
+  } else {
+    for (uint8_t p = 0; p < buffer_pages; ++p) {
+      col |= static_cast<uint64_t>(canvas_[x][p]) << (8 * (first_page_ + p) + column_shift);
+    }
+  }
+  return col;
+}
+
+void GFX::store_column(int x, uint64_t val, uint64_t mask) {
+  mask &= clip_rows_;
+  if (x < clip_.x0 || x > clip_.x1 || not mask) {
+    return;
+  }
+
+  const uint64_t col = (load_column(x) & ~mask) | (val & mask);
+  for (uint8_t p = 0; p < buffer_pages; ++p) {
+    const uint8_t shift = 8 * (first_page_ + p) + column_shift;
+    if (static_cast<uint8_t>(mask >> shift)) {
+      written_[p] |= 1 << (x / block_width);
+    }
+  }
+  if constexpr (buffer_pages == 8 && height == 64) {
+    memcpy(canvas_[x].data(), &col, sizeof(col));
+  } else {
+    for (uint8_t p = 0; p < buffer_pages; ++p) {
+      canvas_[x][p] = col >> (8 * (first_page_ + p) + column_shift);
+    }
+  }
+}
+
+
+void GFX::blit(const Pixel& src_tl, const Pixel& src_br, const Pixel& dst_tl, RasterOp op) {
+  const Pixel src_top_left = to_display(src_tl);
+  const Pixel src_bottom_right = to_display(src_br);
+  const Pixel dst_top_left = to_display(dst_tl);
+  const int width = src_bottom_right.x_ - src_top_left.x_ + 1;
+  const int shift = dst_top_left.y_ - src_top_left.y_;
+  const uint64_t mask = row_mask(dst_top_left.y_, dst_top_left.y_ + src_bottom_right.y_ - src_top_left.y_);
+  if (width <= 0 || not mask) {
+    return;
+  }
+
+  // when moving right, go from right to left, so overlapping columns are read before they are overwritten
+  const bool backwards = dst_top_left.x_ > src_top_left.x_;
+  for (int i = 0; i < width; ++i) {
+    const int col = backwards ? width - 1 - i : i;
+    const int dst_x = dst_top_left.x_ + col;
+    if (dst_x < clip_.x0 || dst_x > clip_.x1) {
+      continue;
+    }
+    const uint64_t src = shift_rows(load_column(src_top_left.x_ + col), shift);
+    store_column(dst_x, apply(op, load_column(dst_x), src), mask);
+  }
+}
+
+void GFX::blit_bitmap(const uint8_t* bitmap, uint8_t width, uint8_t height, const Pixel& dst_tl, RasterOp op) {
+  const Pixel dst_top_left = to_display(dst_tl);
+  height = std::min<uint8_t>(height, 64);
+  const uint8_t bytes_per_col = (height + 7) / 8;
+  const uint64_t mask = row_mask(dst_top_left.y_, dst_top_left.y_ + height - 1);
+  if (not mask) {
+    return;
+  }
+
+  for (int col = 0; col < width; ++col, bitmap += bytes_per_col) {
+    const int dst_x = dst_top_left.x_ + col;
+    if (dst_x < clip_.x0 || dst_x > clip_.x1) {
+      continue;
+    }
+    // the first byte holds the top rows
+    uint64_t src = 0;
+    for (uint8_t k = 0; k < bytes_per_col; ++k) {
+      src |= static_cast<uint64_t>(bitmap[k]) << (56 - 8 * k);
+    }
+    src = shift_rows(src, dst_top_left.y_);
+    store_column(dst_x, apply(op, load_column(dst_x), src), mask);
+  }
+}
+
+void GFX::draw_image(const images::Image_t& image, const Pixel& dst_tl, RasterOp op) {
+  const Pixel dst_top_left = to_display(dst_tl);
+  const int x_end = std::min(dst_top_left.x_ + image.width_, clip_.x1 + 1);
+  if (std::max(dst_top_left.x_, clip_.x0) >= x_end) {
+    return;
+  }
+  const auto on_canvas = [this](int page) { return page >= first_page_ && page < first_page_ + buffer_pages; };
+  const auto combine = [op](uint8_t& byte, uint8_t src, uint8_t mask) {
+    byte = (byte & ~mask) | (static_cast<uint8_t>(apply(op, byte, src)) & mask);
+  };
+
+  // a band goes into the lower rows of its page and the upper rows of the page below, like an unaligned glyph
+  const int shift = dst_top_left.y_ & 7;
+  for (uint8_t band = 0; band < image.bands(); ++band) {
+    const int page = page_of(dst_top_left.y_ + 8 * band);
+    const uint8_t rows = 0xFF << (8 - std::min(8, image.height_ - 8 * band));
+    const uint8_t upper = on_canvas(page) ? (rows >> shift) & clip_mask(page) : 0;
+    const uint8_t lower = shift && on_canvas(page - 1) ? static_cast<uint8_t>(rows << (8 - shift)) & clip_mask(page - 1)
+                                                       : 0;
+    if (not upper && not lower) {
+      // not on the canvas, not even decoded
+      continue;
+    }
+
+    images::BandReader reader(image, band);
+    for (int x = dst_top_left.x_; x < x_end; ++x) {
+      const uint8_t src = reader.next();
+      if (x < clip_.x0) {
+        continue;
+      }
+      if (upper) {
+        combine(canvas_write(x, page), src >> shift, upper);
+      }
+      if (lower) {
+        combine(canvas_write(x, page - 1), src << (8 - shift), lower);
+      }
+    }
+  }
+}
+
+void GFX::invert_rect(const Pixel& rect_tl, const Pixel& rect_br) {
+  const Pixel top_left = to_display(rect_tl);
+  const Pixel bottom_right = to_display(rect_br);
+  const uint64_t mask = row_mask(top_left.y_, bottom_right.y_);
+  for (int x = std::max(top_left.x_, clip_.x0); x <= std::min(bottom_right.x_, clip_.x1); ++x) {
+    store_column(x, ~load_column(x), mask);
+  }
+}
+
+void GFX::scroll(const Pixel& rect_tl, const Pixel& rect_br, int dx, int dy) {
+  const Pixel top_left = to_display(rect_tl);
+  const Pixel bottom_right = to_display(rect_br);
+  // the part of the rectangle, which stays inside after moving
+  const Pixel src_tl{ top_left.x_ + std::max(-dx, 0), top_left.y_ + std::max(-dy, 0) };
+  const Pixel src_br{ bottom_right.x_ - std::max(dx, 0), bottom_right.y_ - std::max(dy, 0) };
+  const Pixel dst_tl{ src_tl.x_ + dx, src_tl.y_ + dy };
+
+  // whole columns of the rectangle are moved, the uncovered rows and columns are cleared afterwards
+  const uint64_t mask = row_mask(top_left.y_, bottom_right.y_);
+  const uint64_t moved = row_mask(dst_tl.y_, dst_tl.y_ + src_br.y_ - src_tl.y_);
+  const int width = src_br.x_ - src_tl.x_ + 1;
+  for (int i = 0; i <= bottom_right.x_ - top_left.x_; ++i) {
+    // same order as blit()
+    const int x = dx > 0 ? bottom_right.x_ - i : top_left.x_ + i;
+    const int src_x = x - dx;
+    uint64_t col = 0;
+    if (width > 0 && utils::within(src_x, src_tl.x_, src_br.x_)) {
+      col = shift_rows(load_column(src_x), dy) & moved;
+    }
+    store_column(x, col, mask);
+  }
+}
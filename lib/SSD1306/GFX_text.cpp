@@ -0,0 +1,122 @@
+/**
+ * @file GFX_text.cpp
+ * @brief Text layout of the GFX class
+ *
+ */
+
+#include "GFX.h"
+
+#include <cstring>
+#include <algorithm>
+#include "nanoprintf.h"
+
+
+/// Drawn at the end of truncated text
+static constexpr char ellipsis[] = "...";
+
+
+std::size_t GFX::fit(const char* txt, std::size_t len, int width) const {
+  const auto& font = *font_;
+  int x = 0;
+  const char* c = txt;
+  while (static_cast<std::size_t>(c - txt) < len && *c) {
+    // the spacing after the last character may be outside of the box
+    const char* next = c;
+    const int advance = font.cursor_advance(utf8::next(next));
+    if (x + advance - font.spacing_ > width) {
+      break;
+    }
+    x += advance;
+    c = next;
+  }
+  return c - txt;
+}
+
+
+int GFX::draw_line(const Pixel& pos, int width, Align align, const char* txt, std::size_t len) {
+  const auto& font = *font_;
+  int text_width = font.text_width(txt, len);
+
+  // truncated text keeps as many characters as fit next to the ellipsis
+  const char* tail = "";
+  if (text_width > width) {
+    const int ellipsis_width = font.text_width(ellipsis) + font.spacing_;
+    if (ellipsis_width <= width) {
+      len = fit(txt, len, width - ellipsis_width);
+      tail = ellipsis;
+    } else {
+      len = fit(txt, len, width);
+    }
+    text_width = font.text_width(txt, len) + (*tail ? ellipsis_width : 0);
+  }
+
+  int x = pos.x_;
+  if (align == Align::CENTER) {
+    x += (width - text_width) / 2;
+  } else if (align == Align::RIGHT) {
+    x += width - text_width;
+  }
+
+  for (const char* end = txt + len; txt < end;) {
+    const char32_t c = utf8::next(txt);
+    draw_char({ x, 8 * pos.y_ }, c);
+    x += font.cursor_advance(c);
+  }
+  for (; *tail; ++tail) {
+    x += draw_char({ x, 8 * pos.y_ }, *tail);
+  }
+  return text_width;
+}
+
+
+int GFX::draw_text_aligned(const Pixel& pos, int width, Align align, const char* txt) {
+  return draw_line(pos, width, align, txt, std::strlen(txt));
+}
+
+
+int GFX::printf_aligned(const Pixel& pos, int width, Align align, const char* fmt, ...) {
+  char buf[text_buffer_size];
+  std::va_list args;
+  va_start(args, fmt);
+  npf_vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  return draw_text_aligned(pos, width, align, buf);
+}
+
+
+uint8_t GFX::draw_text_wrapped(const Pixel& pos, int width, uint8_t max_lines, const char* txt, Align align) {
+  uint8_t lines = 0;
+  while (*txt && lines < max_lines) {
+    const Pixel line_pos{ pos.x_, pos.y_ + lines * font_->pages_ };
+    ++lines;
+
+    // the paragraph up to the next '\n'
+    const std::size_t len = std::strcspn(txt, "\n");
+    if (lines == max_lines) {
+      // no more lines, the rest of the paragraph is truncated
+      draw_line(line_pos, width, align, txt, len);
+      break;
+    }
+
+    std::size_t n = fit(txt, len, width);
+    if (n < len) {
+      // break at the last space which fits, or inside of a long word, after at least one character
+      std::size_t space = n;
+      while (space && txt[space] != ' ') {
+        --space;
+      }
+      n = space ? space : std::max(n, utf8::prefix(txt, 1));
+    }
+    draw_line(line_pos, width, align, txt, n);
+
+    // the spaces at the break and the end of the paragraph aren't drawn
+    txt += n;
+    while (*txt == ' ') {
+      ++txt;
+    }
+    if (*txt == '\n') {
+      ++txt;
+    }
+  }
+  return lines;
+}
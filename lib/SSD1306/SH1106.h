@@ -0,0 +1,227 @@
+/**
+ * @file SH1106.h
+ * @brief SH1106 OLED driver
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include "rtos_i2c.h"
+#include "SSD1306/canvas.h"
+#include "SSD1306/commands.h"
+
+/**
+ * @brief SH1106 driver for 128x64 panels, with the same interface as SSD1306
+ * @details The SH1106 has 132 columns of RAM, the panel shows 128 of them starting at column @p COLUMN_OFFSET. It only
+ * has page addressing, so every page of a window is sent on its own. The commands addressing the page are sent in the
+ * same transfer as its data, each one after a control byte with the continuation bit set. It has no hardware
+ * horizontal scroll.
+ */
+template <uint8_t COLUMN_OFFSET = 2>
+class SH1106 {
+public:
+  static constexpr uint8_t width = canvas::width;          ///< Columns of the panel
+  static constexpr uint8_t height = 64;                    ///< Rows of the panel
+  static constexpr uint8_t pages = height / 8;             ///< Pages of the panel
+  static constexpr uint8_t column_offset = COLUMN_OFFSET;  ///< RAM column of the leftmost column of the panel
+
+  /// @param address 7 bit I2C address, 0x3C or 0x3D depending on the SA0 pin of the panel
+  SH1106(RTOS_I2C& i2c, uint8_t address = 0x3C) : i2c_{ i2c }, addr_{ static_cast<uint8_t>(address << 1) } {
+  }
+
+  /// Initialize the display
+  bool begin() {
+    namespace reg = SSD_1306_reg;
+
+    static constexpr uint8_t config[] = { // turn off display
+                                          reg::SET_DISPLAY_OFF,
+                                          // Display height - 1
+                                          reg::SET_MUX_RATIO, height - 1,
+                                          // display vertical shift
+                                          reg::SET_DISPLAY_OFFSET, 0,
+                                          // display start line is 0
+                                          reg::SET_DISPLAY_START_LINE,
+                                          // segment remap 1 - flip in X
+                                          reg::SET_SEGMENT_REMAP | 0x1,
+                                          // normal COM scan
+                                          reg::SET_COM_OUTPUT_SCAN_DIR,
+                                          // COM pins hardware layout
+                                          reg::SET_COM_HW_CONFIG, 0x2 | (0x1 << 4),
+                                          // set display contrast/brightness
+                                          reg::SET_CONTRAST_CONTROL, 100,
+                                          // use ram to display
+                                          reg::ENTIRE_DISPLAY_FROM_RAM,
+                                          // 1 in RAM means OLED on
+                                          reg::SET_NORMAL_DISPLAY,
+                                          // set oscillator from datasheet
+                                          reg::SET_CLOCK_DIVIDE_RATIO, (0b1000 << 4),
+                                          // enable the DC-DC converter
+                                          SH1106_reg::SET_DC_DC, 0x8A | 0x1,
+                                          // turn on display
+                                          reg::SET_DISPLAY_ON
+    };
+
+    return i2c_.write_register(addr_, 0, const_cast<uint8_t*>(config), sizeof(config));
+  }
+
+  /// Transfer the canvas to the display, starting at page @p first_page
+  template <std::size_t PAGES>
+  bool draw_canvas(canvas::canvas_t<PAGES>& canvas, uint8_t first_page = 0) {
+    for (uint8_t page = 0; page < PAGES; ++page) {
+      if (not draw_window(canvas, page, first_page + page, 0, width - 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Transfer only the @p dirty blocks of the canvas to the display, starting at page @p first_page
+   * @details Each dirty page is sent as one window, from its first to its last dirty block.
+   */
+  template <std::size_t PAGES>
+  bool draw_canvas(canvas::canvas_t<PAGES>& canvas, const canvas::dirty_t<PAGES>& dirty, uint8_t first_page = 0) {
+    for (uint8_t page = 0; page < PAGES; ++page) {
+      if (not dirty[page]) {
+        continue;
+      }
+      const uint8_t first = __builtin_ctz(dirty[page]) * canvas::block_width;
+      const uint8_t last = (32 - __builtin_clz(dirty[page])) * canvas::block_width - 1;
+      if (not draw_window(canvas, page, first_page + page, first, last)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Start sending columns @p first to @p last of all pages of @p canvas
+   * @details The pages are sent one after the other, only the last one is sent in the background. The canvas must not
+   * be modified until wait_canvas() returns.
+   */
+  template <std::size_t PAGES>
+  bool start_canvas(canvas::canvas_t<PAGES>& canvas, uint8_t first, uint8_t last) {
+    for (uint8_t page = 0; page < PAGES; ++page) {
+      if (not draw_window(canvas, page, page, first, last, page == PAGES - 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Wait for the transfer started by start_canvas(). @return true on success
+  bool wait_canvas() {
+    return i2c_.wait_transfer(addr_);
+  }
+
+  /**
+   * @brief Send page @p page of the display, the rows in @p mask from @p canvas, the others from @p other
+   * @details For showing parts of two frames, the top row of the page is the MSB. Needs a canvas of all pages.
+   */
+  template <std::size_t PAGES>
+  bool draw_page(const canvas::canvas_t<PAGES>& canvas, const canvas::canvas_t<PAGES>& other, uint8_t page,
+                 uint8_t mask) {
+    uint8_t* data = start_window(page, 0);
+    for (int x = 0; x < width; ++x) {
+      data[x] = (canvas[x][page] & mask) | (other[x][page] & ~mask);
+    }
+    return send_window(width);
+  }
+
+  /// @name Hardware scrolling
+  /// @details The SH1106 can only move the picture vertically.
+  /// @{
+  /**
+   * @brief RAM row shown in the top row of the panel, moves the whole picture vertically
+   * @details The picture wraps around, rows moved off one edge show up on the other one.
+   */
+  bool set_start_line(uint8_t line) {
+    uint8_t conf = SSD_1306_reg::SET_DISPLAY_START_LINE | (line & 63);
+    return i2c_.write_register(addr_, 0x00, &conf, sizeof(conf));
+  }
+  /// @}
+
+  /// @name RAM fill
+  /// @details Each page is sent in one transfer, see SSD1306. The RAM no longer matches the canvas afterwards, so
+  /// GFX::invalidate() has to be called before drawing again.
+  /// @{
+  /// @brief Set every byte of the RAM to @p val, e.g. 0 to clear it. @return true on success
+  bool set_ram_val(uint8_t val) {
+    for (uint8_t page = 0; page < pages; ++page) {
+      std::fill_n(start_window(page, 0), width, val);
+      if (not send_window(width)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Checkerboard of @p size x @p size pixel squares, @p size 1, 2, 4 or 8, e.g. for burn-in tests
+  bool fill_checkerboard(uint8_t size = 1) {
+    assert_param(size && 8 % size == 0);
+    for (uint8_t page = 0; page < pages; ++page) {
+      uint8_t* data = start_window(page, 0);
+      for (int x = 0; x < width; ++x) {
+        data[x] = canvas::checkerboard_byte(x, page, size);
+      }
+      if (not send_window(width)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  /// @}
+
+  /// Turn of the display for low power
+  bool sleep() {
+    uint8_t conf = SSD_1306_reg::SET_DISPLAY_OFF;
+    return i2c_.write_register(addr_, 0, &conf, sizeof(conf));
+  }
+
+private:
+  /// Bytes before the data in window_buff_, the addressing commands with their control bytes
+  static constexpr uint8_t header_size = 6;
+
+  /**
+   * @brief Prepare the window starting at column @p first of page @p page in window_buff_
+   * @return where the data of the window goes
+   */
+  uint8_t* start_window(uint8_t page, uint8_t first) {
+    // the buffer may still be sent from the last start_canvas(), its result is left to wait_canvas()
+    i2c_.wait_idle();
+    namespace reg = SH1106_reg;
+    const uint8_t column = first + COLUMN_OFFSET;
+    // the first control byte is sent as the register address
+    window_buff_[0] = reg::SET_PAGE_ADDRESS | page;
+    window_buff_[1] = 0x80;
+    window_buff_[2] = reg::SET_LOWER_COLUMN_ADDRESS | (column & 0xF);
+    window_buff_[3] = 0x80;
+    window_buff_[4] = reg::SET_HIGHER_COLUMN_ADDRESS | (column >> 4);
+    window_buff_[5] = 0x40;
+    return window_buff_.data() + header_size;
+  }
+
+  /// Send the window prepared by start_window() with @p len bytes of data, in the background if @p async
+  bool send_window(uint8_t len, bool async = false) {
+    if (async) {
+      return i2c_.write_register_start(addr_, 0x80, window_buff_.data(), header_size + len);
+    }
+    return i2c_.write_register_dma(addr_, 0x80, window_buff_.data(), header_size + len);
+  }
+
+  /// Send columns @p first to @p last of page @p page of @p canvas to page @p display_page
+  template <std::size_t PAGES>
+  bool draw_window(const canvas::canvas_t<PAGES>& canvas, uint8_t page, uint8_t display_page, uint8_t first,
+                   uint8_t last, bool async = false) {
+    uint8_t* data = start_window(display_page, first);
+    for (int x = first; x <= last; ++x) {
+      data[x - first] = canvas[x][page];
+    }
+    return send_window(last - first + 1, async);
+  }
+
+  RTOS_I2C& i2c_;
+  std::array<uint8_t, header_size + width> window_buff_;  ///< Addressing and data of one page of a window
+  const uint8_t addr_;                                    ///< I2C address already shifted
+};
@@ -6,30 +6,234 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
 #include "rtos_i2c.h"
-#include "GFX.h"
+#include "SSD1306/canvas.h"
+#include "SSD1306/commands.h"
 
-/// SSD1306 driver
+/**
+ * @brief SSD1306 driver for panels of 128 x @p HEIGHT pixels, 64 or 32
+ * @details The RAM is written in vertical addressing mode, so a window of whole columns is contiguous in the canvas,
+ * and is sent in a single transfer. The canvas functions take a canvas of any number of pages, see canvas.h.
+ */
+template <uint8_t HEIGHT = 64>
 class SSD1306 {
 public:
-  SSD1306(RTOS_I2C& i2c) : i2c_{ i2c } {
+  static_assert(HEIGHT == 64 || HEIGHT == 32, "SSD1306 panels are 64 or 32 rows high");
+  static constexpr uint8_t width = canvas::width;  ///< Columns of the panel
+  static constexpr uint8_t height = HEIGHT;        ///< Rows of the panel
+  static constexpr uint8_t pages = HEIGHT / 8;     ///< Pages of the panel
+  static constexpr uint8_t column_offset = 0;      ///< RAM column of the leftmost column of the panel
+
+  /// @param address 7 bit I2C address, 0x3C or 0x3D depending on the SA0 pin of the panel
+  SSD1306(RTOS_I2C& i2c, uint8_t address = 0x3C) : i2c_{ i2c }, addr_{ static_cast<uint8_t>(address << 1) } {
   }
 
   /// Initialize the display
-  bool begin();
+  bool begin() {
+    namespace reg = SSD_1306_reg;
+
+    static constexpr uint8_t config[] = { // turn off display
+                                          reg::SET_DISPLAY_OFF,
+                                          // Display height - 1
+                                          reg::SET_MUX_RATIO, HEIGHT - 1,
+                                          // display vertical shift
+                                          reg::SET_DISPLAY_OFFSET, 0,
+                                          // display start line is 0
+                                          reg::SET_DISPLAY_START_LINE,
+                                          // segment remap 1 - flip in X
+                                          reg::SET_SEGMENT_REMAP | 0x1,
+                                          // normal COM scan
+                                          reg::SET_COM_OUTPUT_SCAN_DIR,
+                                          // COM pins hardware layout, 32 row panels use the sequential one
+                                          reg::SET_COM_HW_CONFIG, 0x2 | ((HEIGHT == 64) << 4) | (0x0 << 5),
+                                          // set display contrast/brightness
+                                          reg::SET_CONTRAST_CONTROL, 100,
+                                          // use ram to display
+                                          reg::ENTIRE_DISPLAY_FROM_RAM,
+                                          // 1 in RAM means OLED on
+                                          reg::SET_NORMAL_DISPLAY,
+                                          // set oscillator from datasheet
+                                          reg::SET_CLOCK_DIVIDE_RATIO, (0b1000 << 4),
+                                          // enable charge pump
+                                          reg::CHARGE_PUMP_SETTINGS, 0x10 | (0x1 << 2),
+                                          // set addressing mode
+                                          reg::SET_MEMORY_ADDRESSING_MODE, 0x01,
+                                          // turn on display
+                                          reg::SET_DISPLAY_ON
+    };
+
+    return i2c_.write_register(addr_, 0, const_cast<uint8_t*>(config), sizeof(config));
+  }
+
+  /// Transfer the canvas to the display, starting at page @p first_page
+  template <std::size_t PAGES>
+  bool draw_canvas(canvas::canvas_t<PAGES>& canvas, uint8_t first_page = 0) {
+    if (!set_window(first_page, first_page + PAGES - 1, 0, width - 1)) return false;
+    // data is stored in a 2D std::array, which is contiguous, so we can transfer in one go
+    return i2c_.write_register_dma(addr_, 0x40, reinterpret_cast<uint8_t*>(canvas.data()), sizeof(canvas));
+  }
+
+  /**
+   * @brief Transfer only the @p dirty blocks of the canvas to the display, starting at page @p first_page
+   * @details Each dirty page is sent as one window, from its first to its last dirty block. If all blocks are dirty,
+   * the canvas is sent in one go.
+   */
+  template <std::size_t PAGES>
+  bool draw_canvas(canvas::canvas_t<PAGES>& canvas, const canvas::dirty_t<PAGES>& dirty, uint8_t first_page = 0) {
+    if (std::all_of(dirty.begin(), dirty.end(), [](uint16_t d) { return d == UINT16_MAX; })) {
+      return draw_canvas(canvas, first_page);
+    }
 
-  /// Transfer the canvas to the display
-  bool draw_canvas(GFX::canvas_t&);
+    for (uint8_t page = 0; page < PAGES; ++page) {
+      if (not dirty[page]) {
+        continue;
+      }
+      const uint8_t first = __builtin_ctz(dirty[page]) * canvas::block_width;
+      const uint8_t last = (32 - __builtin_clz(dirty[page])) * canvas::block_width - 1;
 
-  /// set whole ram to value
-  void set_ram_val(uint8_t val);
+      for (int x = first; x <= last; ++x) {
+        window_buff_[x - first] = canvas[x][page];
+      }
+      if (not set_window(first_page + page, first_page + page, first, last)) {
+        return false;
+      }
+      if (not i2c_.write_register_dma(addr_, 0x40, window_buff_.data(), last - first + 1)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Start sending columns @p first to @p last of all pages of @p canvas in the background
+   * @details The columns are contiguous in the canvas, so they are sent as one window in a single transfer. The
+   * canvas must not be modified until wait_canvas() returns.
+   */
+  template <std::size_t PAGES>
+  bool start_canvas(canvas::canvas_t<PAGES>& canvas, uint8_t first, uint8_t last) {
+    if (not set_window(0, PAGES - 1, first, last)) {
+      return false;
+    }
+    return i2c_.write_register_start(addr_, 0x40, canvas[first].data(), (last - first + 1) * PAGES);
+  }
+
+  /// @brief Wait for the transfer started by start_canvas(). @return true on success
+  bool wait_canvas() {
+    return i2c_.wait_transfer(addr_);
+  }
+
+  /**
+   * @brief Send page @p page of the display, the rows in @p mask from @p canvas, the others from @p other
+   * @details For showing parts of two frames, the top row of the page is the MSB. Needs a canvas of all pages.
+   */
+  template <std::size_t PAGES>
+  bool draw_page(const canvas::canvas_t<PAGES>& canvas, const canvas::canvas_t<PAGES>& other, uint8_t page,
+                 uint8_t mask) {
+    for (int x = 0; x < width; ++x) {
+      window_buff_[x] = (canvas[x][page] & mask) | (other[x][page] & ~mask);
+    }
+    if (not set_window(page, page, 0, width - 1)) {
+      return false;
+    }
+    return i2c_.write_register_dma(addr_, 0x40, window_buff_.data(), window_buff_.size());
+  }
+
+  /// @name Hardware scrolling
+  /// @details The display moves the picture by itself, each of these costs only a few command bytes.
+  /// @{
+  /**
+   * @brief RAM row shown in the top row of the panel, moves the whole picture vertically
+   * @details The picture wraps around, rows moved off one edge show up on the other one.
+   */
+  bool set_start_line(uint8_t line) {
+    uint8_t conf = SSD_1306_reg::SET_DISPLAY_START_LINE | (line & 63);
+    return i2c_.write_register(addr_, 0x00, &conf, sizeof(conf));
+  }
+
+  /// @brief Direction of the horizontal scroll, as seen on the canvas
+  enum class Scroll : uint8_t { LEFT, RIGHT };
+
+  /**
+   * @brief Let the display scroll pages @p first_page to @p last_page horizontally, wrapping around, until
+   * stop_scroll()
+   * @details The picture moves one column every @p interval frames of the display, the values are from the datasheet:
+   * 0: 5, 1: 64, 2: 128, 3: 256, 4: 3, 5: 4, 6: 25, 7: 2. The RAM must not be written while scrolling, and the scrolled
+   * pages no longer match the canvas afterwards, so GFX::invalidate() has to be called.
+   */
+  bool start_scroll(Scroll dir, uint8_t first_page, uint8_t last_page, uint8_t interval = 7) {
+    namespace reg = SSD_1306_reg;
+    // the segments are remapped, so the display's right is the canvas' left
+    const uint8_t scroll = dir == Scroll::LEFT ? reg::RIGHT_HORIZONTAL_SCROLL : reg::LEFT_HORIZONTAL_SCROLL;
+    uint8_t buff[]{ reg::STOP_SCROLL, scroll, 0x00, first_page, interval, last_page, 0x00, 0xFF, reg::START_SCROLL };
+    return i2c_.write_register(addr_, 0x00, buff, sizeof(buff));
+  }
+
+  /// @brief Stop the scroll started by start_scroll()
+  bool stop_scroll() {
+    uint8_t conf = SSD_1306_reg::STOP_SCROLL;
+    return i2c_.write_register(addr_, 0x00, &conf, sizeof(conf));
+  }
+  /// @}
+
+  /// @name RAM fill
+  /// @details The whole RAM is streamed from window_buff_ holding a repeated pattern, in one transfer of one page size
+  /// per page, which takes about one frame. A running asynchronous transfer is finished first. The RAM no longer
+  /// matches the canvas afterwards, so GFX::invalidate() has to be called before drawing again.
+  /// @{
+  /// @brief Set every byte of the RAM to @p val, e.g. 0 to clear it. @return true on success
+  bool set_ram_val(uint8_t val) {
+    window_buff_.fill(val);
+    return fill_ram();
+  }
+
+  /// @brief Checkerboard of @p size x @p size pixel squares, @p size 1, 2, 4 or 8, e.g. for burn-in tests
+  bool fill_checkerboard(uint8_t size = 1) {
+    assert_param(size && 8 % size == 0);
+    // in vertical addressing the bytes are column by column, so the buffer is 16 or 32 columns, a whole number of
+    // squares
+    for (std::size_t i = 0; i < window_buff_.size(); ++i) {
+      window_buff_[i] = canvas::checkerboard_byte(i / pages, i % pages, size);
+    }
+    return fill_ram();
+  }
+  /// @}
 
   /// Turn of the display for low power
-  bool sleep();
+  bool sleep() {
+    uint8_t conf = SSD_1306_reg::SET_DISPLAY_OFF;
+    return i2c_.write_register(addr_, 0, &conf, sizeof(conf));
+  }
 
 private:
   /// Reset the ram address in the display
-  bool reset_ram_address();
+  bool reset_ram_address() {
+    return set_window(0, pages - 1, 0, width - 1);
+  }
+
+  /// Send window_buff_ until the whole RAM is filled with it, its size is a multiple of the pattern period
+  bool fill_ram() {
+    // the address keeps incrementing from one transfer to the next
+    if (not reset_ram_address()) {
+      return false;
+    }
+    for (uint8_t page = 0; page < pages; ++page) {
+      if (not i2c_.write_register_dma(addr_, 0x40, window_buff_.data(), window_buff_.size())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Limit the RAM address to pages @p first_page to @p last_page, columns @p first to @p last
+  bool set_window(uint8_t first_page, uint8_t last_page, uint8_t first, uint8_t last) {
+    uint8_t buff[]{ SSD_1306_reg::SET_PAGE_ADDRESS, first_page, last_page,
+                    SSD_1306_reg::SET_COLUMN_ADDRESS, first, last };
+    return i2c_.write_register(addr_, 0x00, buff, sizeof(buff));
+  }
+
   RTOS_I2C& i2c_;
-  inline static constexpr uint8_t addr_{ 0x3C << 1 };  ///< I2C address already shifted
+  std::array<uint8_t, width> window_buff_;             ///< One page of a window, the canvas stores pages interleaved
+  const uint8_t addr_;                                 ///< I2C address already shifted
 };
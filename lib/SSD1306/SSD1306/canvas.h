@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file canvas.h
+ * @brief Memory layout shared by GFX and the display drivers
+ * @details The canvas stores column after column, each column holds one byte per page of the display, with the top row
+ * of the page in the MSB. The drivers only depend on this layout, not on GFX.
+ */
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+
+namespace canvas {
+
+  inline constexpr uint8_t width = 128;                       ///< Columns of every panel
+  inline constexpr uint8_t block_width = 8;                   ///< Columns in one block of dirty tracking
+  inline constexpr uint8_t num_blocks = width / block_width;  ///< Blocks in one page
+
+  /// Canvas of @p PAGES pages, where each bit is one pixel
+  template <std::size_t PAGES>
+  using canvas_t = std::array<std::array<uint8_t, PAGES>, width>;
+
+  /// Bit b of element p is set, if block b (columns 8b to 8b+7) of page p of the canvas is dirty
+  template <std::size_t PAGES>
+  using dirty_t = std::array<uint16_t, PAGES>;
+
+  /// @brief Byte of page @p page of column @p x of a checkerboard of @p size pixel squares, e.g. for burn-in tests
+  constexpr uint8_t checkerboard_byte(int x, int page, uint8_t size) {
+    uint8_t byte = 0;
+    for (int bit = 0; bit < 8; ++bit) {
+      if ((x / size + (8 * page + bit) / size) & 1) {
+        byte |= 1 << bit;
+      }
+    }
+    return byte;
+  }
+
+  static_assert(checkerboard_byte(0, 0, 1) == 0xAA && checkerboard_byte(1, 0, 1) == 0x55);
+  static_assert(checkerboard_byte(0, 1, 8) == 0xFF && checkerboard_byte(8, 1, 8) == 0);
+
+}  // namespace canvas
@@ -44,3 +44,14 @@ namespace SSD_1306_reg {
     CHARGE_PUMP_SETTINGS = 0x8D,
   };
 }
+
+/// Commands of the SH1106, which differ from the SSD1306. The others, e.g. the start line, are the same
+namespace SH1106_reg {
+
+  enum commands : uint8_t {
+    SET_LOWER_COLUMN_ADDRESS = 0x00,   ///< | low nibble of the column
+    SET_HIGHER_COLUMN_ADDRESS = 0x10,  ///< | high nibble of the column
+    SET_PAGE_ADDRESS = 0xB0,           ///< | page, the only addressing mode is page addressing
+    SET_DC_DC = 0xAD,                  ///< followed by 0x8A | on, the charge pump of the SH1106
+  };
+}
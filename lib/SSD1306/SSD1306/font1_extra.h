@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * @file font1_extra.h
+ * @brief Glyphs of font1 outside of ASCII, only the ones used in the sources
+ * @details Generated by create_font_data/subset_font.py, don't edit.
+ */
+
+#include <array>
+#include <cstdint>
+
+namespace fonts {
+
+  /// Codepoints of the extra glyphs, sorted
+  inline constexpr std::array<uint16_t, 2> font1_extra_codepoints{
+    0x00e1,  // 'á'
+    0x00e9,  // 'é'
+  };
+
+  /// Columns of the extra glyphs, in the order of their codepoints
+  inline constexpr std::array<uint8_t, 16> font1_extra_data{
+    0x1c, 0x3e, 0x22, 0x62, 0xe2, 0xbe, 0x3e, 0x00,  // 'á'
+    0x1c, 0x3e, 0x2a, 0x6a, 0xea, 0xba, 0x18, 0x00,  // 'é'
+  };
+
+}  // namespace fonts
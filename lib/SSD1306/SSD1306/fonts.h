@@ -1,6 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+
+#include <array>
+
+#include "utf8.h"
+#include "font1_extra.h"
 
 /**
  * @brief Define new fonts here, see README on how-to
@@ -11,65 +17,384 @@ namespace fonts {
   /**
    * @brief Press Start K font bitmap
    * @details Author: Codeman38, Font can be found at https://www.dafont.com/press-start.font
+   * Generated by create_font_data/img_to_code.py: one column per byte, the top row is the MSB, glyph after glyph.
    */
-  constexpr uint8_t font1_data[] = {
-    0x00, 0x18, 0x6c, 0x00, 0x18, 0x62, 0x38, 0x18, 0x0c, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x38, 0x18, 0x7c,
-    0x7e, 0x1c, 0xfc, 0x3c, 0xfe, 0x78, 0x7c, 0x00, 0x00, 0x0c, 0x00, 0x30, 0x7c, 0x7c, 0x38, 0xfc, 0x3c, 0xf8, 0xfe,
-    0xfe, 0x3e, 0xc6, 0x7e, 0x06, 0xc6, 0xc0, 0xc6, 0xc6, 0x7c, 0xfc, 0x7c, 0xfc, 0x78, 0x7e, 0xc6, 0xc6, 0xc6, 0xc6,
-    0x66, 0xfe, 0x3c, 0x40, 0x3c, 0x10, 0x00, 0x60, 0x00, 0xc0, 0x00, 0x06, 0x00, 0x1c, 0x00, 0xc0, 0x18, 0x18, 0xc0,
-    0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x18, 0x38, 0x00,
-    0x00, 0x3c, 0x6c, 0x6c, 0x3e, 0x66, 0x6c, 0x18, 0x18, 0x18, 0x6c, 0x18, 0x00, 0x00, 0x00, 0x06, 0x4c, 0x38, 0xc6,
-    0x0c, 0x3c, 0xc0, 0x60, 0xc6, 0x84, 0xc6, 0x00, 0x00, 0x18, 0x00, 0x18, 0xc6, 0xce, 0x6c, 0xc6, 0x66, 0xcc, 0xc0,
-    0xc0, 0x60, 0xc6, 0x18, 0x06, 0xcc, 0xc0, 0xee, 0xe6, 0xc6, 0xc6, 0xc6, 0xc6, 0xcc, 0x18, 0xc6, 0xc6, 0xc6, 0xee,
-    0x66, 0x0e, 0x30, 0x60, 0x0c, 0x28, 0x00, 0x30, 0x00, 0xc0, 0x00, 0x06, 0x00, 0x36, 0x00, 0xc0, 0x00, 0x00, 0xc0,
-    0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x18, 0x0c, 0x00,
-    0x00, 0x3c, 0x6c, 0xfe, 0x60, 0x0c, 0x38, 0x18, 0x30, 0x0c, 0x38, 0x18, 0x00, 0x00, 0x00, 0x0c, 0xc6, 0x18, 0x0e,
-    0x18, 0x6c, 0xfc, 0xc0, 0x0c, 0xc4, 0xc6, 0x18, 0x18, 0x30, 0x3c, 0x0c, 0x06, 0xd2, 0xc6, 0xc6, 0xc0, 0xc6, 0xc0,
-    0xc0, 0xc0, 0xc6, 0x18, 0x06, 0xd8, 0xc0, 0xfe, 0xf6, 0xc6, 0xc6, 0xc6, 0xc6, 0xc0, 0x18, 0xc6, 0xc6, 0xd6, 0x7c,
-    0x66, 0x1c, 0x30, 0x30, 0x0c, 0x44, 0x00, 0x00, 0x7e, 0xfc, 0x7c, 0x7e, 0x7c, 0x30, 0x7e, 0xfc, 0x38, 0x38, 0xcc,
-    0x18, 0xec, 0xfc, 0x7c, 0xfc, 0x7e, 0xfc, 0x7c, 0xfc, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6, 0xfe, 0x30, 0x18, 0x0c, 0x60,
-    0x00, 0x3c, 0x00, 0x6c, 0x3c, 0x18, 0x76, 0x00, 0x30, 0x0c, 0xfe, 0x7e, 0x00, 0x7e, 0x00, 0x18, 0xc6, 0x18, 0x3c,
-    0x3c, 0xcc, 0x06, 0xfc, 0x18, 0x78, 0x7e, 0x18, 0x18, 0x60, 0x00, 0x06, 0x1c, 0xd2, 0xc6, 0xfc, 0xc0, 0xc6, 0xfc,
-    0xfc, 0xce, 0xfe, 0x18, 0x06, 0xf0, 0xc0, 0xfe, 0xfe, 0xc6, 0xc6, 0xc6, 0xce, 0x7c, 0x18, 0xc6, 0xc6, 0xfe, 0x38,
-    0x3c, 0x38, 0x30, 0x18, 0x0c, 0x82, 0x00, 0x00, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6, 0x7c, 0xc6, 0xc6, 0x18, 0x18, 0xd8,
-    0x18, 0xfe, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6, 0xe0, 0x30, 0xc6, 0xc6, 0xc6, 0x6c, 0xc6, 0x1c, 0x60, 0x18, 0x06, 0xf2,
-    0x00, 0x18, 0x00, 0xfe, 0x06, 0x30, 0xdc, 0x00, 0x30, 0x0c, 0x38, 0x18, 0x00, 0x00, 0x00, 0x30, 0xc6, 0x18, 0x78,
-    0x06, 0xfe, 0x06, 0xc6, 0x30, 0x9e, 0x06, 0x00, 0x00, 0x30, 0x3c, 0x0c, 0x38, 0xce, 0xfe, 0xc6, 0xc0, 0xc6, 0xc0,
-    0xc0, 0xc6, 0xc6, 0x18, 0x06, 0xf8, 0xc0, 0xd6, 0xde, 0xc6, 0xfc, 0xde, 0xf8, 0x06, 0x18, 0xc6, 0x6c, 0xfe, 0x7c,
-    0x18, 0x70, 0x30, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0xc6, 0xc6, 0xc0, 0xc6, 0xfe, 0x30, 0xc6, 0xc6, 0x18, 0x18, 0xf0,
-    0x18, 0xd6, 0xc6, 0xc6, 0xc6, 0xc6, 0xc0, 0x7c, 0x30, 0xc6, 0x6c, 0xd6, 0x38, 0xc6, 0x38, 0x30, 0x18, 0x0c, 0x9e,
-    0x00, 0x00, 0x00, 0x6c, 0x7c, 0x66, 0xcc, 0x00, 0x18, 0x18, 0x6c, 0x18, 0x18, 0x00, 0x18, 0x60, 0x64, 0x18, 0xe0,
-    0xc6, 0x0c, 0xc6, 0xc6, 0x30, 0x86, 0x0c, 0x18, 0x18, 0x18, 0x00, 0x18, 0x00, 0xc0, 0xc6, 0xc6, 0x66, 0xcc, 0xc0,
-    0xc0, 0x66, 0xc6, 0x18, 0xc6, 0xdc, 0xc0, 0xc6, 0xce, 0xc6, 0xc0, 0xcc, 0xdc, 0xc6, 0x18, 0xc6, 0x38, 0x6c, 0xee,
-    0x18, 0xe0, 0x30, 0x06, 0x0c, 0x00, 0x00, 0x00, 0xc6, 0xc6, 0xc0, 0xc6, 0xc0, 0x30, 0x7e, 0xc6, 0x18, 0x18, 0xd8,
-    0x18, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6, 0xc0, 0x0e, 0x36, 0xc6, 0x38, 0xfe, 0x6c, 0x7e, 0x70, 0x30, 0x18, 0x0c, 0x0c,
-    0x00, 0x18, 0x00, 0x00, 0x18, 0x46, 0x76, 0x00, 0x0c, 0x30, 0x00, 0x00, 0x18, 0x00, 0x18, 0x40, 0x38, 0x7e, 0xfe,
-    0x7c, 0x0c, 0x7c, 0x7c, 0x30, 0x7c, 0x78, 0x18, 0x18, 0x0c, 0x00, 0x30, 0x38, 0x7e, 0xc6, 0xfc, 0x3c, 0xf8, 0xfe,
-    0xc0, 0x3e, 0xc6, 0x7e, 0x7c, 0xce, 0xfe, 0xc6, 0xc6, 0x7c, 0xc0, 0x7a, 0xce, 0x7c, 0x18, 0x7c, 0x10, 0x44, 0xc6,
-    0x18, 0xfe, 0x3c, 0x02, 0x3c, 0x00, 0x00, 0x00, 0x7e, 0xfc, 0x7e, 0x7e, 0x7c, 0x30, 0x06, 0xc6, 0x3c, 0x18, 0xcc,
-    0x3c, 0xc6, 0xc6, 0x7c, 0xfc, 0x7e, 0xc0, 0xfc, 0x1c, 0x7e, 0x10, 0x6c, 0xc6, 0x06, 0xfe, 0x1c, 0x18, 0x38, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x70, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0xc0, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x18, 0x00, 0x00
+  inline constexpr uint8_t font1_data[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ' '
+    0x00, 0x00, 0x70, 0xfa, 0xfa, 0x70, 0x00, 0x00,  // '!'
+    0x00, 0xe0, 0xe0, 0x00, 0xe0, 0xe0, 0x00, 0x00,  // '"'
+    0x28, 0x7c, 0x7c, 0x28, 0x7c, 0x7c, 0x28, 0x00,  // '#'
+    0x00, 0x24, 0x74, 0xd6, 0xd6, 0x5c, 0x48, 0x00,  // '$'
+    0x00, 0xc6, 0xcc, 0x18, 0x30, 0x66, 0xc6, 0x00,  // '%'
+    0x0c, 0x5e, 0xf2, 0xba, 0xec, 0x5e, 0x12, 0x00,  // '&'
+    0x00, 0x00, 0x00, 0xe0, 0xe0, 0x00, 0x00, 0x00,  // '\''
+    0x00, 0x00, 0x38, 0x7c, 0xc6, 0x82, 0x00, 0x00,  // '('
+    0x00, 0x00, 0x82, 0xc6, 0x7c, 0x38, 0x00, 0x00,  // ')'
+    0x10, 0x54, 0x7c, 0x38, 0x7c, 0x54, 0x10, 0x00,  // '*'
+    0x00, 0x10, 0x10, 0x7c, 0x7c, 0x10, 0x10, 0x00,  // '+'
+    0x00, 0x00, 0x01, 0x07, 0x06, 0x00, 0x00, 0x00,  // ','
+    0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00,  // '-'
+    0x00, 0x00, 0x00, 0x06, 0x06, 0x00, 0x00, 0x00,  // '.'
+    0x00, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0, 0x00,  // '/'
+    0x38, 0x7c, 0x86, 0x82, 0xc2, 0x7c, 0x38, 0x00,  // '0'
+    0x00, 0x02, 0x42, 0xfe, 0xfe, 0x02, 0x02, 0x00,  // '1'
+    0x46, 0xce, 0x9e, 0x9a, 0xba, 0xf2, 0x62, 0x00,  // '2'
+    0x04, 0x86, 0x92, 0xb2, 0xf2, 0xde, 0x8c, 0x00,  // '3'
+    0x18, 0x38, 0x68, 0xc8, 0xfe, 0xfe, 0x08, 0x00,  // '4'
+    0xe4, 0xe6, 0xa2, 0xa2, 0xa2, 0xbe, 0x1c, 0x00,  // '5'
+    0x3c, 0x7e, 0xd2, 0x92, 0x92, 0x9e, 0x0c, 0x00,  // '6'
+    0xc0, 0xc0, 0x8e, 0x9e, 0xb0, 0xe0, 0xc0, 0x00,  // '7'
+    0x6c, 0xb2, 0x92, 0x9a, 0x9a, 0x6e, 0x0c, 0x00,  // '8'
+    0x60, 0xf2, 0x92, 0x92, 0x96, 0xfc, 0x78, 0x00,  // '9'
+    0x00, 0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00,  // ':'
+    0x00, 0x00, 0x01, 0x37, 0x36, 0x00, 0x00, 0x00,  // ';'
+    0x00, 0x10, 0x38, 0x6c, 0xc6, 0x82, 0x00, 0x00,  // '<'
+    0x00, 0x00, 0x28, 0x28, 0x28, 0x28, 0x00, 0x00,  // '='
+    0x00, 0x00, 0x82, 0xc6, 0x6c, 0x38, 0x10, 0x00,  // '>'
+    0x40, 0xc0, 0x8a, 0x9a, 0x9a, 0xf0, 0x60, 0x00,  // '?'
+    0x7c, 0xfe, 0x82, 0xb2, 0xca, 0xca, 0x7a, 0x00,  // '@'
+    0x3e, 0x7e, 0xc8, 0x88, 0xc8, 0x7e, 0x3e, 0x00,  // 'A'
+    0xfe, 0xfe, 0x92, 0x92, 0x92, 0xfe, 0x6c, 0x00,  // 'B'
+    0x38, 0x7c, 0xc6, 0x82, 0x82, 0xc6, 0x44, 0x00,  // 'C'
+    0xfe, 0xfe, 0x82, 0x82, 0xc6, 0x7c, 0x38, 0x00,  // 'D'
+    0xfe, 0xfe, 0x92, 0x92, 0x92, 0x92, 0x82, 0x00,  // 'E'
+    0xfe, 0xfe, 0x90, 0x90, 0x90, 0x90, 0x80, 0x00,  // 'F'
+    0x38, 0x7c, 0xc6, 0x82, 0x92, 0x9e, 0x9e, 0x00,  // 'G'
+    0xfe, 0xfe, 0x10, 0x10, 0x10, 0xfe, 0xfe, 0x00,  // 'H'
+    0x00, 0x82, 0x82, 0xfe, 0xfe, 0x82, 0x82, 0x00,  // 'I'
+    0x04, 0x06, 0x02, 0x02, 0x02, 0xfe, 0xfc, 0x00,  // 'J'
+    0xfe, 0xfe, 0x18, 0x3c, 0x6e, 0xc6, 0x82, 0x00,  // 'K'
+    0xfe, 0xfe, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00,  // 'L'
+    0xfe, 0xfe, 0x70, 0x38, 0x70, 0xfe, 0xfe, 0x00,  // 'M'
+    0xfe, 0xfe, 0x70, 0x38, 0x1c, 0xfe, 0xfe, 0x00,  // 'N'
+    0x7c, 0xfe, 0x82, 0x82, 0x82, 0xfe, 0x7c, 0x00,  // 'O'
+    0xfe, 0xfe, 0x88, 0x88, 0x88, 0xf8, 0x70, 0x00,  // 'P'
+    0x7c, 0xfe, 0x82, 0x8a, 0x8e, 0xfc, 0x7a, 0x00,  // 'Q'
+    0xfe, 0xfe, 0x88, 0x8c, 0x9e, 0xf6, 0x72, 0x00,  // 'R'
+    0x64, 0xf6, 0x92, 0x92, 0xd2, 0x5e, 0x0c, 0x00,  // 'S'
+    0x00, 0x80, 0x80, 0xfe, 0xfe, 0x80, 0x80, 0x00,  // 'T'
+    0xfc, 0xfe, 0x02, 0x02, 0x02, 0xfe, 0xfc, 0x00,  // 'U'
+    0xf0, 0xf8, 0x0c, 0x06, 0x0c, 0xf8, 0xf0, 0x00,  // 'V'
+    0xf8, 0xfe, 0x1c, 0x38, 0x1c, 0xfe, 0xf8, 0x00,  // 'W'
+    0xc6, 0xee, 0x7c, 0x38, 0x7c, 0xee, 0xc6, 0x00,  // 'X'
+    0x00, 0xe0, 0xf0, 0x1e, 0x1e, 0xf0, 0xe0, 0x00,  // 'Y'
+    0x86, 0x8e, 0x9e, 0xba, 0xf2, 0xe2, 0xc2, 0x00,  // 'Z'
+    0x00, 0x00, 0xfe, 0xfe, 0x82, 0x82, 0x00, 0x00,  // '['
+    0x00, 0xc0, 0x60, 0x30, 0x18, 0x0c, 0x06, 0x00,  // '\\'
+    0x00, 0x00, 0x82, 0x82, 0xfe, 0xfe, 0x00, 0x00,  // ']'
+    0x10, 0x20, 0x40, 0x80, 0x40, 0x20, 0x10, 0x00,  // '^'
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,  // '_'
+    0x00, 0x80, 0xc0, 0x40, 0x00, 0x00, 0x00, 0x00,  // '`'
+    0x1c, 0x3e, 0x22, 0x22, 0x22, 0x3e, 0x3e, 0x00,  // 'a'
+    0xfe, 0xfe, 0x22, 0x22, 0x22, 0x3e, 0x1c, 0x00,  // 'b'
+    0x1c, 0x3e, 0x22, 0x22, 0x22, 0x32, 0x12, 0x00,  // 'c'
+    0x1c, 0x3e, 0x22, 0x22, 0x22, 0xfe, 0xfe, 0x00,  // 'd'
+    0x1c, 0x3e, 0x2a, 0x2a, 0x2a, 0x3a, 0x18, 0x00,  // 'e'
+    0x00, 0x10, 0x7e, 0xfe, 0x90, 0xd0, 0x40, 0x00,  // 'f'
+    0x18, 0x3d, 0x25, 0x25, 0x25, 0x3f, 0x3e, 0x00,  // 'g'
+    0xfe, 0xfe, 0x20, 0x20, 0x20, 0x3e, 0x1e, 0x00,  // 'h'
+    0x00, 0x00, 0x22, 0xbe, 0xbe, 0x02, 0x00, 0x00,  // 'i'
+    0x00, 0x01, 0x21, 0xbf, 0xbe, 0x00, 0x00, 0x00,  // 'j'
+    0xfe, 0xfe, 0x08, 0x1c, 0x36, 0x22, 0x00, 0x00,  // 'k'
+    0x00, 0x00, 0x82, 0xfe, 0xfe, 0x02, 0x00, 0x00,  // 'l'
+    0x3e, 0x3e, 0x30, 0x18, 0x30, 0x3e, 0x1e, 0x00,  // 'm'
+    0x3e, 0x3e, 0x20, 0x20, 0x20, 0x3e, 0x1e, 0x00,  // 'n'
+    0x1c, 0x3e, 0x22, 0x22, 0x22, 0x3e, 0x1c, 0x00,  // 'o'
+    0x3f, 0x3f, 0x22, 0x22, 0x22, 0x3e, 0x1c, 0x00,  // 'p'
+    0x1c, 0x3e, 0x22, 0x22, 0x22, 0x3f, 0x3f, 0x00,  // 'q'
+    0x3e, 0x3e, 0x20, 0x20, 0x20, 0x30, 0x10, 0x00,  // 'r'
+    0x12, 0x3a, 0x3a, 0x2a, 0x2e, 0x2e, 0x04, 0x00,  // 's'
+    0x20, 0x20, 0x7c, 0x7e, 0x22, 0x26, 0x04, 0x00,  // 't'
+    0x3c, 0x3e, 0x02, 0x02, 0x02, 0x3e, 0x3e, 0x00,  // 'u'
+    0x30, 0x38, 0x0c, 0x06, 0x0c, 0x38, 0x30, 0x00,  // 'v'
+    0x3c, 0x3e, 0x06, 0x0c, 0x06, 0x3e, 0x3c, 0x00,  // 'w'
+    0x22, 0x36, 0x1c, 0x08, 0x1c, 0x36, 0x22, 0x00,  // 'x'
+    0x38, 0x3d, 0x05, 0x05, 0x05, 0x3f, 0x3e, 0x00,  // 'y'
+    0x22, 0x26, 0x2e, 0x3e, 0x3a, 0x32, 0x22, 0x00,  // 'z'
+    0x00, 0x10, 0x7c, 0xee, 0x82, 0x82, 0x00, 0x00,  // '{'
+    0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,  // '|'
+    0x00, 0x00, 0x82, 0x82, 0xee, 0x7c, 0x10, 0x00,  // '}'
+    0x18, 0x30, 0x30, 0x18, 0x0c, 0x0c, 0x18, 0x00,  // '~'
   };
 
   /**
    * @brief Font data with pointer to the struct
+   * @details Each glyph is stored as its columns. A column is @ref pages_ bytes, the top page first, with the top row
+   * of each page in the MSB, which is the layout of the display RAM. Glyphs on a page boundary are thus copied byte by
+   * byte.
    *
+   * Monospace fonts store all glyphs with @ref width columns. Proportional fonts set @ref widths_ and @ref index_,
+   * see glyph_index().
+   *
+   * Characters are codepoints, text is UTF-8. The first glyphs are the codepoints from @ref offset_ on, one after the
+   * other, e.g. ASCII, and are found right away. Fonts generated for a subset of characters(see create_font_data)
+   * append the few other glyphs which are used, with their sorted codepoints in @ref codepoints_, and these are found
+   * by a binary search.
    */
   struct Font_t {
-    const uint8_t* const font_;  ///< Pointer to the font
-    const uint8_t width;         ///< Width of characters
-    const uint16_t num_glyphs_;  ///< Number of characters in font
-    const uint8_t offset_;       ///< The ascii code of the first character in the font
+    const uint8_t* const font_;                   ///< Pointer to the font
+    const uint8_t width;                          ///< Width of characters, the widest one for proportional fonts
+    const uint16_t num_glyphs_;                   ///< Number of characters in font
+    const uint8_t offset_;                        ///< Codepoint of the first character in the font
+    const uint8_t pages_ = 1;                     ///< Height of the glyphs in pages(8 rows)
+    const uint8_t spacing_ = 0;                   ///< Empty columns after each glyph
+    const uint8_t* const widths_ = nullptr;       ///< Width of each glyph, nullptr for monospace fonts
+    const uint16_t* const index_ = nullptr;       ///< Offset of each glyph in font_, nullptr for monospace fonts
+    const uint16_t* const codepoints_ = nullptr;  ///< Sorted codepoints of the last num_sparse_ glyphs
+    const uint8_t num_sparse_ = 0;                ///< Glyphs at the end, which are looked up in codepoints_
+
+    /// @return height of the glyphs in pixels
+    constexpr uint8_t height() const {
+      return 8 * pages_;
+    }
+
+    /// @return index of the glyph of @p c, -1 if the font doesn't contain it
+    constexpr int index_of(char32_t c) const {
+      const int dense = num_glyphs_ - num_sparse_;
+      if (c >= offset_ && c - offset_ < static_cast<char32_t>(dense)) {
+        return c - offset_;
+      }
+      int lo = 0;
+      int hi = num_sparse_;
+      while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (codepoints_[mid] < c) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      return lo < num_sparse_ && codepoints_[lo] == c ? dense + lo : -1;
+    }
+
+    /// @return the columns of the glyph at @p index, see index_of()
+    constexpr const uint8_t* glyph_at(int index) const {
+      return font_ + (index_ ? index_[index] : index * width * pages_);
+    }
+
+    /// @return the width of the glyph at @p index in pixels, see index_of()
+    constexpr uint8_t width_at(int index) const {
+      return widths_ ? widths_[index] : width;
+    }
+
+    /// @return true if the font contains @p c
+    constexpr bool contains(char32_t c) const {
+      return index_of(c) >= 0;
+    }
+
+    /// @return true if the font contains every character of the UTF-8 @p txt, e.g. to static_assert localized text
+    constexpr bool covers(const char* txt) const {
+      while (*txt) {
+        if (not contains(utf8::next(txt))) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// @return the columns of @p c, or nullptr if the font doesn't contain it
+    constexpr const uint8_t* glyph(char32_t c) const {
+      const int index = index_of(c);
+      return index < 0 ? nullptr : glyph_at(index);
+    }
+
+    /// @return the width of @p c in pixels, 0 if the font doesn't contain it
+    constexpr uint8_t glyph_width(char32_t c) const {
+      const int index = index_of(c);
+      return index < 0 ? 0 : width_at(index);
+    }
+
+    /// @return how far the cursor moves after @p c
+    constexpr uint8_t advance(char32_t c) const {
+      const int index = index_of(c);
+      return index < 0 ? 0 : width_at(index) + spacing_;
+    }
+
+    /// @return how far the text cursor moves after @p c, characters missing in the font are skipped like a space
+    constexpr uint8_t cursor_advance(char32_t c) const {
+      const int index = index_of(c);
+      return (index < 0 ? width : width_at(index)) + spacing_;
+    }
+
+    /// @return width of the UTF-8 @p txt, up to @p len bytes, in pixels, without the spacing after the last character
+    constexpr int text_width(const char* txt, std::size_t len = SIZE_MAX) const {
+      int ret = 0;
+      for (const char* c = txt; *c && static_cast<std::size_t>(c - txt) < len;) {
+        ret += cursor_advance(utf8::next(c));
+      }
+      return ret > spacing_ ? ret - spacing_ : ret;
+    }
   };
 
+  /// @return true, if the @p codepoints of the sparse glyphs of a font are sorted, for the binary search
+  template <std::size_t N>
+  constexpr bool sorted(const std::array<uint16_t, N>& codepoints) {
+    for (std::size_t i = 1; i < N; ++i) {
+      if (codepoints[i - 1] >= codepoints[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @return the glyphs of @p a followed by the glyphs of @p b, e.g. a font and its generated extra glyphs
+  template <std::size_t N, std::size_t M>
+  constexpr std::array<uint8_t, N + M> join(const uint8_t (&a)[N], const std::array<uint8_t, M>& b) {
+    std::array<uint8_t, N + M> ret{};
+    for (std::size_t i = 0; i < N; ++i) {
+      ret[i] = a[i];
+    }
+    for (std::size_t i = 0; i < M; ++i) {
+      ret[N + i] = b[i];
+    }
+    return ret;
+  }
+
+  /// @return the offsets of the glyphs in the data of a proportional font with the @p widths and @p pages
+  template <std::size_t N>
+  constexpr std::array<uint16_t, N> glyph_index(const uint8_t (&widths)[N], uint8_t pages) {
+    std::array<uint16_t, N> ret{};
+    uint16_t offset = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      ret[i] = offset;
+      offset += widths[i] * pages;
+    }
+    return ret;
+  }
+
+  /// ASCII glyphs of font1, followed by the extra glyphs in font1_extra.h
+  inline constexpr auto font1_glyphs = join(font1_data, font1_extra_data);
+
   /**
    * @brief Font 1
    *
    */
-  constexpr Font_t font1{ .font_ = font1_data, .width = 8, .num_glyphs_ = sizeof(font1_data) / 8, .offset_ = 32 };
+  inline constexpr Font_t font1{ .font_ = font1_glyphs.data(),
+                                 .width = 8,
+                                 .num_glyphs_ = font1_glyphs.size() / 8,
+                                 .offset_ = 32,
+                                 .codepoints_ = font1_extra_codepoints.data(),
+                                 .num_sparse_ = font1_extra_codepoints.size() };
+
+  static_assert(font1.glyph('|')[3] == 0xff, "font data has to be column-major");
+  static_assert(font1.glyph('\x7f') == nullptr && font1.glyph('\n') == nullptr);
+  static_assert(font1.text_width("00:00") == 40);
+  static_assert(sorted(font1_extra_codepoints) && font1_extra_data.size() == 8 * font1_extra_codepoints.size());
+  static_assert(font1.index_of(0xFFFD) == -1 && font1.text_width("a\xFF" "b") == 3 * 8);
+
+  /**
+   * @brief Large seven segment digits for the clock, 0-9 and ':'
+   * @details Generated by create_font_data/create_digits.py
+   */
+  inline constexpr uint8_t digits_data[] = {
+    // '0'
+    0x1f, 0xfc, 0x7f, 0xf0, 0x3f, 0xfe, 0xff, 0xf8,
+    0x5f, 0xfc, 0x7f, 0xf4, 0xe0, 0x00, 0x00, 0x0e,
+    0xe0, 0x00, 0x00, 0x0e, 0xe0, 0x00, 0x00, 0x0e,
+    0xe0, 0x00, 0x00, 0x0e, 0xe0, 0x00, 0x00, 0x0e,
+    0xe0, 0x00, 0x00, 0x0e, 0xe0, 0x00, 0x00, 0x0e,
+    0xe0, 0x00, 0x00, 0x0e, 0x5f, 0xfc, 0x7f, 0xf4,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // '1'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x1f, 0xfc, 0x7f, 0xf0,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // '2'
+    0x00, 0x00, 0x7f, 0xf0, 0x00, 0x00, 0xff, 0xf8,
+    0x40, 0x01, 0x7f, 0xf4, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0x5f, 0xfd, 0x00, 0x04,
+    0x3f, 0xfe, 0x00, 0x00, 0x1f, 0xfc, 0x00, 0x00,
+    // '3'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x01, 0x00, 0x04, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0x5f, 0xfd, 0x7f, 0xf4,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // '4'
+    0x1f, 0xfc, 0x00, 0x00, 0x3f, 0xfe, 0x00, 0x00,
+    0x1f, 0xfd, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00,
+    0x00, 0x03, 0x80, 0x00, 0x00, 0x03, 0x80, 0x00,
+    0x00, 0x03, 0x80, 0x00, 0x00, 0x03, 0x80, 0x00,
+    0x00, 0x03, 0x80, 0x00, 0x00, 0x03, 0x80, 0x00,
+    0x00, 0x03, 0x80, 0x00, 0x1f, 0xfd, 0x7f, 0xf0,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // '5'
+    0x1f, 0xfc, 0x00, 0x00, 0x3f, 0xfe, 0x00, 0x00,
+    0x5f, 0xfd, 0x00, 0x04, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0x40, 0x01, 0x7f, 0xf4,
+    0x00, 0x00, 0xff, 0xf8, 0x00, 0x00, 0x7f, 0xf0,
+    // '6'
+    0x1f, 0xfc, 0x7f, 0xf0, 0x3f, 0xfe, 0xff, 0xf8,
+    0x5f, 0xfd, 0x7f, 0xf4, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0x40, 0x01, 0x7f, 0xf4,
+    0x00, 0x00, 0xff, 0xf8, 0x00, 0x00, 0x7f, 0xf0,
+    // '7'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+    0xe0, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+    0xe0, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+    0xe0, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+    0xe0, 0x00, 0x00, 0x00, 0x5f, 0xfc, 0x7f, 0xf0,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // '8'
+    0x1f, 0xfc, 0x7f, 0xf0, 0x3f, 0xfe, 0xff, 0xf8,
+    0x5f, 0xfd, 0x7f, 0xf4, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0x5f, 0xfd, 0x7f, 0xf4,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // '9'
+    0x1f, 0xfc, 0x00, 0x00, 0x3f, 0xfe, 0x00, 0x00,
+    0x5f, 0xfd, 0x00, 0x04, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0xe0, 0x03, 0x80, 0x0e,
+    0xe0, 0x03, 0x80, 0x0e, 0x5f, 0xfd, 0x7f, 0xf4,
+    0x3f, 0xfe, 0xff, 0xf8, 0x1f, 0xfc, 0x7f, 0xf0,
+    // ':'
+    0x00, 0xe0, 0x0e, 0x00, 0x00, 0xe0, 0x0e, 0x00,
+    0x00, 0xe0, 0x0e, 0x00,
+  };
+
+  /// Widths of the large digits, the ':' is narrow
+  inline constexpr uint8_t digits_widths[] = { 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 3 };
+
+  /// Offsets of the large digits
+  inline constexpr auto digits_index = glyph_index(digits_widths, 4);
+
+  /**
+   * @brief Proportional 4 pages high digits, for the time on the main screen
+   *
+   */
+  inline constexpr Font_t digits{ .font_ = digits_data,
+                                  .width = 14,
+                                  .num_glyphs_ = sizeof(digits_widths),
+                                  .offset_ = '0',
+                                  .pages_ = 4,
+                                  .spacing_ = 2,
+                                  .widths_ = digits_widths,
+                                  .index_ = digits_index.data() };
+
+  static_assert(sizeof(digits_data) == (10 * 14 + 3) * 4, "widths don't match the data");
+  static_assert(digits.glyph(':') == digits_data + 10 * 14 * 4);
+  static_assert(digits.text_width("00:00") == 4 * (14 + 2) + 3 && digits.height() == 32);
+  static_assert(digits.glyph('A') == nullptr && digits.advance('A') == 0);
+  static_assert(digits.text_width("1 2") == 2 * (14 + 2) + 14 && digits.text_width("12:34", 2) == 14 + 2 + 14);
 
 }  // namespace fonts
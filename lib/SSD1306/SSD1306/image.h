@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * @file image.h
+ * @brief Compressed images, drawn by GFX::draw_image()
+ * @details Generated by create_font_data/img_to_asset.py, see there for the format. The image is split into bands of
+ * 8 rows, each band is its columns, one byte per column with the top row in the MSB, and compressed on its own. So a
+ * band is decoded straight into the canvas, and a strip of the canvas skips the bands it doesn't show.
+ */
+
+#include <cstdint>
+#include <cstddef>
+
+namespace images {
+
+  /// Compressed image
+  struct Image_t {
+    uint8_t width_;          ///< Columns of the image, up to 128
+    uint8_t height_;         ///< Rows of the image, up to 64
+    const uint16_t* bands_;  ///< Offset of each band in data_, and the size of data_ at the end
+    const uint8_t* data_;    ///< Compressed bands
+
+    /// @return bands of 8 rows, the last one may be partial
+    constexpr uint8_t bands() const {
+      return (height_ + 7) / 8;
+    }
+  };
+
+  /**
+   * @brief Decodes a band, one byte after the other
+   * @details A control byte c below 0x80 is followed by c + 1 literal bytes, otherwise the next byte is repeated
+   * c - 0x80 + 3 times.
+   */
+  class BandReader {
+  public:
+    constexpr BandReader(const Image_t& image, uint8_t band) : data_{ image.data_ + image.bands_[band] } {
+    }
+
+    /// @return the next column of the band
+    constexpr uint8_t next() {
+      if (left_ == 0) {
+        const uint8_t control = *data_++;
+        repeat_ = control & 0x80;
+        left_ = repeat_ ? control - 0x80 + 3 : control + 1;
+        if (repeat_) {
+          value_ = *data_++;
+        }
+      }
+      --left_;
+      return repeat_ ? value_ : *data_++;
+    }
+
+    /// @return where the compressed data continues
+    constexpr const uint8_t* position() const {
+      return data_;
+    }
+
+  private:
+    const uint8_t* data_;   ///< Next compressed byte
+    uint8_t left_{ 0 };     ///< Bytes left in the current run
+    uint8_t value_{ 0 };    ///< Value of the current repeat
+    bool repeat_{ false };  ///< The current run repeats value_, otherwise it's literal bytes
+  };
+
+  /// @return true, if every band of @p image decodes to exactly one byte per column, for a static_assert
+  constexpr bool valid(const Image_t& image) {
+    if (image.width_ == 0 || image.width_ > 128 || image.height_ == 0 || image.height_ > 64) {
+      return false;
+    }
+    for (uint8_t band = 0; band < image.bands(); ++band) {
+      BandReader reader(image, band);
+      for (int x = 0; x < image.width_; ++x) {
+        reader.next();
+      }
+      if (reader.position() != image.data_ + image.bands_[band + 1]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  namespace detail {
+    inline constexpr uint16_t test_bands[] = { 0, 5 };
+    inline constexpr uint8_t test_data[] = { 0x80, 0xAA, 0x01, 0x01, 0x02 };  // 3 x 0xAA, 0x01, 0x02
+    static_assert(valid({ 5, 8, test_bands, test_data }));
+    static_assert(not valid({ 4, 8, test_bands, test_data }));
+  }  // namespace detail
+
+}  // namespace images
@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * @file animation.h
+ * @brief Easing and frame timing of animations
+ * @details Progress is fixed point, from 0 to animation::one. Everything is constexpr, and tested at compile time below.
+ * @code
+ * animation::Tween slide;
+ * slide.start(0, 64, 250, animation::Easing::OUT, HAL_GetTick());
+ * // on each frame
+ * const int32_t rows = slide.value(HAL_GetTick());
+ * @endcode
+ */
+
+#include <cstdint>
+
+namespace animation {
+
+  inline constexpr uint16_t one = 256;        ///< Progress of a finished animation
+  inline constexpr uint32_t frame_time = 20;  ///< ms from one frame of a running animation to the next, 50 fps
+
+  /// @brief Shape of the motion
+  enum class Easing : uint8_t {
+    LINEAR,  ///< constant speed
+    IN,      ///< starts slow, quadratic
+    OUT,     ///< ends slow, quadratic
+    IN_OUT,  ///< starts and ends slow, quadratic
+  };
+
+  /// @brief Eased progress of progress @p t, both from 0 to one
+  constexpr uint16_t ease(Easing easing, uint16_t t) {
+    const uint32_t u = t;
+    switch (easing) {
+      case Easing::LINEAR:
+        return t;
+      case Easing::IN:
+        return u * u / one;
+      case Easing::OUT:
+        return u * (2 * one - u) / one;
+      case Easing::IN_OUT:
+        return t < one / 2 ? 2 * u * u / one : one - 2 * (one - u) * (one - u) / one;
+    }
+    return t;
+  }
+
+  /// @brief A value moving from one number to another in a given time
+  class Tween {
+  public:
+    /// @brief Move from @p from to @p to in @p duration ms, starting at tick @p now
+    constexpr void start(int32_t from, int32_t to, uint32_t duration, Easing easing, uint32_t now) {
+      from_ = from;
+      to_ = to;
+      start_ = now;
+      duration_ = duration;
+      easing_ = easing;
+    }
+
+    /// @return true, if the value still moves at tick @p now
+    constexpr bool running(uint32_t now) const {
+      return now - start_ < duration_;
+    }
+
+    /// @return the value at tick @p now, the target once the time is over
+    constexpr int32_t value(uint32_t now) const {
+      if (not running(now)) {
+        return to_;
+      }
+      const uint16_t t = (now - start_) * one / duration_;
+      return from_ + (to_ - from_) * ease(easing_, t) / one;
+    }
+
+    /// @return ms from tick @p now to the next frame, 0 if it isn't running
+    constexpr uint32_t next_frame(uint32_t now) const {
+      if (not running(now)) {
+        return 0;
+      }
+      const uint32_t left = duration_ - (now - start_);
+      return left < frame_time ? left : frame_time;
+    }
+
+  private:
+    int32_t from_{ 0 };
+    int32_t to_{ 0 };
+    uint32_t start_{ 0 };     ///< Tick of the start
+    uint32_t duration_{ 0 };  ///< ms
+    Easing easing_{ Easing::LINEAR };
+  };
+
+
+  namespace detail {
+    /// @return true, if all easings start at 0, end at one and never move backwards
+    constexpr bool monotonic() {
+      for (auto easing : { Easing::LINEAR, Easing::IN, Easing::OUT, Easing::IN_OUT }) {
+        if (ease(easing, 0) != 0 || ease(easing, one) != one) {
+          return false;
+        }
+        for (uint16_t t = 1; t <= one; ++t) {
+          if (ease(easing, t) < ease(easing, t - 1)) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    /// @return value of a tween from @p from to @p to in 100 ms, @p elapsed ms after the start at tick 1000
+    constexpr int32_t tween_at(int32_t from, int32_t to, Easing easing, uint32_t elapsed) {
+      Tween tween;
+      tween.start(from, to, 100, easing, 1000);
+      return tween.value(1000 + elapsed);
+    }
+  }  // namespace detail
+
+  static_assert(detail::monotonic());
+  static_assert(ease(Easing::IN_OUT, one / 2) == one / 2);
+  static_assert(ease(Easing::OUT, one / 2) > ease(Easing::LINEAR, one / 2));
+  static_assert(ease(Easing::IN, one / 2) < ease(Easing::LINEAR, one / 2));
+  static_assert(detail::tween_at(0, 64, Easing::LINEAR, 50) == 32);
+  static_assert(detail::tween_at(64, 0, Easing::LINEAR, 25) == 48);
+  static_assert(detail::tween_at(0, 64, Easing::OUT, 100) == 64);
+  static_assert(detail::tween_at(0, 64, Easing::OUT, 5000) == 64);
+
+}  // namespace animation
@@ -0,0 +1,23 @@
+/**
+ * @file display_driver.h
+ * @brief Driver of the panel the firmware is built for
+ * @details The panel is selected with a build flag, e.g. in platformio.ini:
+ *  - none: SSD1306, 128x64
+ *  - DISPLAY_SSD1306_128X32: SSD1306, 128x32
+ *  - DISPLAY_SH1106: SH1106, 128x64 in the middle of its 132 columns
+ *
+ * All drivers have the same interface, and GFX takes its geometry from Display. It's resolved at compile time, so
+ * there are no virtual calls, and each driver sends the canvas the way its controller is addressed fastest.
+ */
+#pragma once
+
+#if defined(DISPLAY_SH1106)
+#include "SH1106.h"
+using Display = SH1106<>;
+#elif defined(DISPLAY_SSD1306_128X32)
+#include "SSD1306.h"
+using Display = SSD1306<32>;
+#else
+#include "SSD1306.h"
+using Display = SSD1306<>;
+#endif
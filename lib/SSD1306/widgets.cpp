@@ -0,0 +1,76 @@
+/**
+ * @file widgets.cpp
+ * @brief Retained mode widgets
+ *
+ */
+
+#include "widgets.h"
+
+#include <algorithm>
+
+namespace widgets {
+
+  void Widget::render(GFX& gfx, bool force, bool blink_on) {
+    const bool shown = visible_ && (blink_on || not blink_);
+    if (not force && not dirty_ && shown == shown_) {
+      // the canvas already shows the widget
+      return;
+    }
+
+    const auto& font = gfx.font();
+    gfx.set_font(*font_);
+
+    if (not force && shown && shown_ && draw_changed(gfx)) {
+      // only the changed parts were drawn again, the box stays the same
+      dirty_ = false;
+      gfx.set_font(font);
+      return;
+    }
+
+    if (not force && width_) {
+      // clear the last content, a cleared canvas doesn't need this
+      const int top = 8 * line_;
+      gfx.draw_rectangle({ x_, top }, { x_ + width_ - 1, top + 8 * lines() - 1 }, false);
+    }
+    width_ = 0;
+    dirty_ = false;
+    shown_ = shown;
+
+    if (shown) {
+      gfx.move_cursor({ x_, line_ });
+      width_ = std::clamp(draw(gfx), 0, 128 - x_);
+    }
+    gfx.set_font(font);
+  }
+
+
+  int Label::draw(GFX& gfx) {
+    return draw_text(gfx, text_);
+  }
+
+
+  int Number::draw(GFX& gfx) {
+    char buf[GFX::text_buffer_size];
+    if (format_) {
+      *format_(buf, value_) = '\0';
+    } else {
+      npf_snprintf(buf, sizeof(buf), fmt_, value_);
+    }
+    return draw_text(gfx, buf);
+  }
+
+
+  int List::draw(GFX& gfx) {
+    for (int i = 0; i < num_items_; ++i) {
+      gfx.move_cursor({ x_, line_ + i });
+      gfx.draw_text(" ");
+      gfx.draw_text(items_[i]);
+    }
+
+    // inverse video highlight of the selected line
+    const int top = 8 * (line_ + selected_);
+    gfx.invert_rect({ x_, top }, { 127, top + 7 });
+    return 128 - x_;
+  }
+
+}  // namespace widgets
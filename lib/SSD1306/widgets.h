@@ -0,0 +1,311 @@
+#pragma once
+
+/**
+ * @file widgets.h
+ * @brief Retained mode widgets for GFX
+ *
+ */
+
+#include <cstdint>
+#include <cstdarg>
+#include <cstring>
+
+#include "GFX.h"
+#include "nanoprintf.h"
+#include "format.h"
+
+/**
+ * @brief Widgets remember what they last drew, and are only drawn again when that changes
+ * @details A screen keeps its widgets as members, updates their values in update(), and renders them in draw(). If the
+ * canvas still holds the last frame, only the invalidated widgets are cleared and drawn again, so an idle screen
+ * doesn't render anything. If the canvas was cleared(first frame of a screen, page streaming mode), everything is drawn
+ * with @p force:
+ * @code
+ * void Screen::draw() {
+ *   if (redraw_all()) {
+ *     gfx.clear_canvas();
+ *   }
+ *   widgets::render(gfx, redraw_all(), blink_on_, title_, value_);
+ * }
+ * @endcode
+ */
+namespace widgets {
+
+  /// Base of all widgets, a box starting at a pixel column and a line(page) of the display
+  class Widget {
+  public:
+    Widget(uint8_t x, uint8_t line, const fonts::Font_t& font = fonts::font1) : font_{ &font }, x_{ x }, line_{ line } {
+    }
+    virtual ~Widget() = default;
+
+    /// Draw the widget again in the next render()
+    void invalidate() {
+      dirty_ = true;
+    }
+
+    /// Hidden widgets are cleared from the canvas
+    void set_visible(bool visible) {
+      visible_ = visible;
+    }
+
+    /// Blinking widgets are only shown in the on phase of the blink passed to render()
+    void set_blink(bool blink) {
+      blink_ = blink;
+    }
+
+    /// Text is aligned in a box of @p width pixels, and truncated to it. The whole box is cleared on a change
+    void set_align(GFX::Align align, uint8_t width) {
+      align_ = align;
+      box_width_ = width;
+      invalidate();
+    }
+
+    /**
+     * @brief Draws the widget, if it was invalidated or it was shown/hidden
+     * @param gfx canvas to draw to
+     * @param force draw, even if nothing changed, e.g. if the canvas was cleared. The old box is not cleared then.
+     * @param blink_on phase of the blink
+     */
+    void render(GFX& gfx, bool force, bool blink_on = true);
+
+  protected:
+    /// Draws the content at the cursor, which is already moved to the widget with its font selected
+    /// @return width of the drawn content in pixels
+    virtual int draw(GFX& gfx) = 0;
+
+    /// @brief Draws only the changed parts of the widget, which is shown and stays where it is, with its font selected
+    /// @return false, if the whole widget has to be cleared and drawn again
+    virtual bool draw_changed(GFX&) {
+      return false;
+    }
+
+    /// @return height of the widget in lines
+    virtual uint8_t lines() const {
+      return font_->pages_;
+    }
+
+    /// @return width of text drawn from the widget to the cursor, the rest of the line if the text wrapped
+    int text_width(const GFX& gfx) const {
+      return gfx.cursor().y_ == line_ ? gfx.cursor().x_ - x_ : 128 - x_;
+    }
+
+    /// Draws @p txt at the cursor, or aligned in the box set by set_align(). @return width to clear
+    int draw_text(GFX& gfx, const char* txt) {
+      if (box_width_) {
+        gfx.draw_text_aligned({ x_, line_ }, box_width_, align_, txt);
+        return box_width_;
+      }
+      gfx.draw_text(txt);
+      return text_width(gfx);
+    }
+
+    const fonts::Font_t* font_;  ///< Font of the text
+    uint8_t x_;                  ///< First column
+    uint8_t line_;               ///< First line
+
+  private:
+    uint8_t width_{ 0 };                    ///< Width of the box drawn last, cleared before drawing again
+    bool dirty_{ true };                    ///< Content changed since the last render()
+    bool visible_{ true };                  ///< Shown, see set_visible()
+    bool blink_{ false };                   ///< Blinking, see set_blink()
+    bool shown_{ false };                   ///< Was shown in the last render()
+    uint8_t box_width_{ 0 };                ///< Width of the box of aligned text, 0 if not aligned
+    GFX::Align align_{ GFX::Align::LEFT };  ///< Alignment of the text in the box
+  };
+
+  /// Renders all @p widgets, see Widget::render()
+  template <class... Widgets>
+  void render(GFX& gfx, bool force, bool blink_on, Widgets&... widgets) {
+    (widgets.render(gfx, force, blink_on), ...);
+  }
+
+
+  /// Static text, e.g. a caption or a unit
+  class Label : public Widget {
+  public:
+    Label(uint8_t x, uint8_t line, const char* text, const fonts::Font_t& font = fonts::font1)
+        : Widget(x, line, font), text_{ text } {
+    }
+
+    /// @param text has to outlive the label, it is compared by its address, so string literals are cheap to set
+    void set_text(const char* text) {
+      if (text != text_) {
+        text_ = text;
+        invalidate();
+      }
+    }
+
+  protected:
+    int draw(GFX& gfx) override;
+
+  private:
+    const char* text_;
+  };
+
+
+  /// An integer printed with a printf format or a formatter, which is only formatted again when the value changes
+  class Number : public Widget {
+  public:
+    /// Writes @p value to @p out, @return end of the written characters, see format.h
+    using format_t = char* (*)(char* out, int32_t value);
+
+    /// @param fmt printf format with one %d, e.g. "%d C"
+    Number(uint8_t x, uint8_t line, const char* fmt, const fonts::Font_t& font = fonts::font1)
+        : Widget(x, line, font), fmt_{ fmt } {
+    }
+
+    /// @param format writes the value without parsing a format string, e.g. format::two_digits()
+    Number(uint8_t x, uint8_t line, format_t format, const fonts::Font_t& font = fonts::font1)
+        : Widget(x, line, font), format_{ format } {
+    }
+
+    void set(int32_t value) {
+      if (value != value_) {
+        value_ = value;
+        invalidate();
+      }
+    }
+
+  protected:
+    int draw(GFX& gfx) override;
+
+  private:
+    const char* fmt_{ nullptr };
+    format_t format_{ nullptr };
+    int32_t value_{ 0 };
+  };
+
+
+  /// Formatted text of up to N - 1 characters, invalidated only if the formatted text changed
+  template <uint8_t N>
+  class Text : public Widget {
+  public:
+    using Widget::Widget;
+
+    /// printf-style formatting of the text
+    void set(const char* fmt, ...) {
+      char buf[N];
+      std::va_list args;
+      va_start(args, fmt);
+      npf_vsnprintf(buf, N, fmt, args);
+      va_end(args);
+      set_text(buf);
+    }
+
+    /// Copies @p txt, e.g. formatted with format.h, it is truncated to N - 1 characters
+    void set_text(const char* txt) {
+      if (std::strncmp(txt, text_, N - 1) != 0) {
+        *format::text(text_, txt, N - 1) = '\0';
+        invalidate();
+      }
+    }
+
+  protected:
+    int draw(GFX& gfx) override {
+      return draw_text(gfx, text_);
+    }
+
+  private:
+    char text_[N]{};
+  };
+
+
+  /**
+   * @brief Text of up to N - 1 characters, of which only the changed glyph cells are drawn again, e.g. a clock
+   * @details Each character is a cell, placed like draw_text() places it. If only characters of the same width
+   * changed, just their cells are cleared and drawn, so a clock tick draws a glyph or two instead of the whole text.
+   * Otherwise, e.g. if the text got shorter, the whole widget is drawn again. Each byte is a cell, so the text has to
+   * be ASCII, like the digits of a clock.
+   */
+  template <uint8_t N>
+  class Cells : public Widget {
+    static_assert(N <= 32, "the changed cells are a 32-bit mask");
+
+  public:
+    using Widget::Widget;
+
+    /// Copies @p txt, e.g. formatted with format.h, it is truncated to N - 1 characters
+    void set_text(const char* txt) {
+      for (uint8_t i = 0; i < N - 1; ++i) {
+        const char c = *txt ? *txt++ : '\0';
+        if (c == text_[i]) {
+          continue;
+        }
+        if (not c || not text_[i] || font_->cursor_advance(c) != font_->cursor_advance(text_[i])) {
+          moved_ = true;
+        }
+        text_[i] = c;
+        changed_ |= 1u << i;
+      }
+      if (changed_) {
+        invalidate();
+      }
+    }
+
+  protected:
+    int draw(GFX& gfx) override {
+      changed_ = 0;
+      moved_ = false;
+      gfx.draw_text(text_);
+      return text_width(gfx);
+    }
+
+    bool draw_changed(GFX& gfx) override {
+      if (moved_ || not changed_) {
+        // all cells moved, or the widget was invalidated as a whole
+        return false;
+      }
+      const int top = 8 * line_;
+      int x = x_;
+      for (uint8_t i = 0; text_[i]; ++i) {
+        const int advance = font_->cursor_advance(text_[i]);
+        if (changed_ & (1u << i)) {
+          gfx.draw_rectangle({ x, top }, { x + advance - 1, top + font_->height() - 1 }, false);
+          gfx.draw_char({ x, top }, text_[i]);
+        }
+        x += advance;
+      }
+      changed_ = 0;
+      return true;
+    }
+
+  private:
+    char text_[N]{};
+    uint32_t changed_{ 0 };  ///< Bit i is set, if character i changed since it was drawn
+    bool moved_{ false };    ///< A change moved the following cells, so all have to be drawn
+  };
+
+
+  /// Items on consecutive lines, the selected one in inverse video. Spans to the right edge of the display
+  class List : public Widget {
+  public:
+    /// @param items has to outlive the list
+    List(uint8_t x, uint8_t line, const char* const* items, uint8_t num_items)
+        : Widget(x, line), items_{ items }, num_items_{ num_items } {
+    }
+
+    void select(uint8_t item) {
+      if (item != selected_) {
+        selected_ = item;
+        invalidate();
+      }
+    }
+
+    uint8_t selected() const {
+      return selected_;
+    }
+
+  protected:
+    int draw(GFX& gfx) override;
+
+    uint8_t lines() const override {
+      return num_items_;
+    }
+
+  private:
+    const char* const* items_;
+    uint8_t num_items_;
+    uint8_t selected_{ 0 };
+  };
+
+}  // namespace widgets
@@ -0,0 +1,67 @@
+/**
+ * @file command_macros.cpp
+ */
+
+#include "command_macros.h"
+#include <cstring>
+
+
+MacroStore::macro_t* MacroStore::get(const char* name, size_t name_len) {
+  for (auto& m : macros_) {
+    if (m.name_[0] && strlen(m.name_.data()) == name_len && 0 == strncmp(m.name_.data(), name, name_len)) {
+      return &m;
+    }
+  }
+  return nullptr;
+}
+
+bool MacroStore::define(const char* name, size_t name_len, const char* body, size_t body_len, bool append) {
+  if (name_len == 0 || name_len > max_name) {
+    return false;
+  }
+
+  macro_t* m = get(name, name_len);
+  size_t offset = 0;
+  if (m && append) {
+    offset = strlen(m->body_.data());
+  } else if (not m) {
+    // find an empty slot
+    for (auto& slot : macros_) {
+      if (not slot.name_[0]) {
+        m = &slot;
+        break;
+      }
+    }
+  }
+
+  // appended commands are separated from the existing ones
+  const size_t separator = offset ? 1 : 0;
+  if (not m || offset + separator + body_len > max_body) {
+    return false;
+  }
+
+  if (separator) {
+    m->body_[offset++] = ';';
+  }
+
+  memcpy(m->name_.data(), name, name_len);
+  m->name_[name_len] = '\0';
+  memcpy(m->body_.data() + offset, body, body_len);
+  m->body_[offset + body_len] = '\0';
+  return true;
+}
+
+const char* MacroStore::find(const char* name, size_t name_len) const {
+  const macro_t* m = const_cast<MacroStore*>(this)->get(name, name_len);
+  return m ? m->body_.data() : nullptr;
+}
+
+bool MacroStore::remove(const char* name, size_t name_len) {
+  macro_t* m = get(name, name_len);
+  if (not m) {
+    return false;
+  }
+  m->name_[0] = '\0';
+  m->body_[0] = '\0';
+  return true;
+}
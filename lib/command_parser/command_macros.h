@@ -0,0 +1,58 @@
+/**
+ * @file command_macros.h
+ * @brief Storage for named command macros
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Stores a fixed number of named macros in RAM
+ * @details A macro is a name and a body, the body is a sequence of commands separated by
+ * StringParser::is_separator(). Names and bodies are passed with their length, as they point directly into the
+ * command buffer, and are not null terminated.
+ */
+class MacroStore {
+public:
+  static constexpr size_t max_macros = 4;  ///< Number of macros that can be stored
+  static constexpr size_t max_name = 8;    ///< Max length of a name
+  static constexpr size_t max_body = 96;   ///< Max length of a body
+
+  /**
+   * @brief Creates or replaces macro @p name. If @p append is set, the body is appended to an existing macro
+   * @return true on success, false if the store is full, or the name/body is too long
+   */
+  bool define(const char* name, size_t name_len, const char* body, size_t body_len, bool append = false);
+
+  /// @brief Returns the null terminated body of macro @p name, or nullptr
+  const char* find(const char* name, size_t name_len) const;
+
+  /// @brief Deletes macro @p name. @return true if the macro existed
+  bool remove(const char* name, size_t name_len);
+
+  /// @brief Calls @p callback with the name and body of each macro
+  template <class LAMBDA>
+  void for_each(LAMBDA&& callback) const {
+    for (const auto& m : macros_) {
+      if (m.name_[0]) {
+        callback(m.name_.data(), m.body_.data());
+      }
+    }
+  }
+
+private:
+  /// One macro, the slot is empty if name_ is empty
+  struct macro_t {
+    std::array<char, max_name + 1> name_;
+    std::array<char, max_body + 1> body_;
+  };
+
+  /// Returns the macro with name @p name, or nullptr
+  macro_t* get(const char* name, size_t name_len);
+
+  std::array<macro_t, max_macros> macros_{};  ///< The macro slots
+};
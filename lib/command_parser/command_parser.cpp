@@ -7,110 +7,64 @@
 #include <cstring>
 #include <algorithm>
 
-bool StringParser::is_end_char(char c) {
-  return c == '\n' || c == '\r' || c == '\0';
-}
-
-bool StringParser::tick(char c) {
-  bool command_ready = false;
-  switch (state_) {
-    case WAITING_START:
-      if (not std::isspace(c)) {
-        reset();
-        write_index_ = 0;
-        command_[write_index_++] = c;
-        state_ = READING_COMMAND;
-      }
-      break;
-
-    case READING_COMMAND:
-      if (write_index_ == command_.size()) {
-        state_ = COMMAND_OVERFLOW;
-      } else if (is_end_char(c)) {
-        state_ = WAITING_START;
-        command_ready = true;
-      } else {
-        command_[write_index_++] = c;
-      }
-      break;
-
-    case COMMAND_OVERFLOW:
-      if (is_end_char(c)) {
-        state_ = WAITING_START;
-      }
-      break;
-  }
-
-  if (command_ready) {
-    process_command();
-    return true;
-  } else {
-    return false;
-  }
-}
-
-void StringParser::process_command() {
-  const size_t cmd_len = strlen(command_.data());
+CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_T_code() const {
+  int code = parser_->get_code();
 
-  if (cmd_len < 2) {
-    return;
-  }
+  switch (code) {
+    case 100:
+      return &CommandDispatcher::T100;
 
-  if (std::isalpha(command_[0])) {
-    prefix_ = std::toupper(command_[0]);
-  }
-  if (std::isdigit(command_[1])) {
-    code_ = atoi(command_.data() + 1);
+    default:
+      return nullptr;
   }
 }
 
-void StringParser::reset() {
-  prefix_ = std::nullopt;
-  code_ = std::nullopt;
-  write_index_ = 0;
-  std::fill(command_.begin(), command_.end(), 0);
-}
+CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_A_code() const {
+  int code = parser_->get_code();
 
-bool StringParser::get_parameter(char param, int16_t& dest, int16_t def) const {
-  dest = def;
-  if (!is_valid()) return false;
-  const auto end = command_.data() + strlen(command_.data());     // create crude end iterator
-  const auto place = std::find(command_.data() + 1, end, param);  // skip first char / prefix when searching
-  if (place == end) return false;
+  switch (code) {
+    case 0:
+      return &CommandDispatcher::A0;
+    case 1:
+      return &CommandDispatcher::A1;
+    case 2:
+      return &CommandDispatcher::A2;
+    case 3:
+      return &CommandDispatcher::A3;
 
-  if (*(place + 1) == '\0' || std::isblank(*(place + 1))) {
-    // parameter has no value
-    return true;
+    default:
+      return nullptr;
   }
-
-  dest = atoi(place + 1);  // convert to int
-  return true;
 }
 
-CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_T_code() const {
-  int code = parser_.get_code();
+CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_M_code() const {
+  int code = parser_->get_code();
 
   switch (code) {
-    case 100:
-      return &CommandDispatcher::T100;
+    case 0:
+      return &CommandDispatcher::M0;
+    case 1:
+      return &CommandDispatcher::M1;
+    case 2:
+      return &CommandDispatcher::M2;
+    case 3:
+      return &CommandDispatcher::M3;
 
     default:
       return nullptr;
   }
 }
 
-CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_A_code() const {
-  int code = parser_.get_code();
+CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_S_code() const {
+  int code = parser_->get_code();
 
   switch (code) {
     case 0:
-      return &CommandDispatcher::A0;
+      return &CommandDispatcher::S0;
     case 1:
-      return &CommandDispatcher::A1;
+      return &CommandDispatcher::S1;
     case 2:
-      return &CommandDispatcher::A2;
-    case 3:
-      return &CommandDispatcher::A3;
+      return &CommandDispatcher::S2;
 
     default:
       return nullptr;
@@ -120,17 +74,21 @@ CommandDispatcher::cmd_fcn_ptr CommandDispatcher::search_A_code() const {
 
 
 CommandDispatcher::cmd_fcn_ptr CommandDispatcher::get_fcn_from_cmd() const {
-  if (not parser_.is_valid()) {
+  if (not parser_->is_valid()) {
     return nullptr;
   }
 
-  char prefix = parser_.get_prefix();
+  char prefix = parser_->get_prefix();
 
   switch (prefix) {
     case 'A':
       return search_A_code();
     case 'T':
       return search_T_code();
+    case 'M':
+      return search_M_code();
+    case 'S':
+      return search_S_code();
 
     default:
       return nullptr;
@@ -142,18 +100,83 @@ void CommandDispatcher::send_ack(int free) {
 }
 
 void CommandDispatcher::send_err(int free) {
-  uart_->println("Err %d: Unknown command %s", free, parser_.get_str());
+  if (parser_->is_overflow()) {
+    uart_->println("Err %d: Command too long", free);
+  } else {
+    uart_->println("Err %d: Unknown command %s", free, parser_->get_str());
+  }
 }
 
-void CommandDispatcher::input_char(char c) {
-  if (parser_.tick(c)) {
-    auto cmd = get_fcn_from_cmd();
-    auto free = uart_->get_dma_buff().get_num_free();
-    if (cmd) {
-      send_ack(free);
-      (this->*cmd)();
+void CommandDispatcher::run_single() {
+  auto cmd = get_fcn_from_cmd();
+  auto free = uart_->get_dma_buff().get_num_free();
+  if (cmd) {
+    send_ack(free);
+    (this->*cmd)();
+  } else {
+    send_err(free);
+  }
+}
+
+void CommandDispatcher::run_batched() {
+  auto cmd = get_fcn_from_cmd();
+  src_->batch_.running = true;
+  if (cmd == &CommandDispatcher::M2) {
+    // a macro counts as the commands it runs, M2 only counts itself if it fails
+    M2();
+    return;
+  }
+  count_command(cmd != nullptr);
+  if (cmd) {
+    (this->*cmd)();
+  }
+}
+
+void CommandDispatcher::count_command(bool ok) {
+  auto& batch = src_->batch_;
+  if (batch.total < UINT16_MAX) {
+    ++batch.total;
+  }
+  if (ok) {
+    return;
+  }
+  if (batch.failed == 0) {
+    batch.failed = 1;
+    batch.first_failed = batch.total;
+  } else if (batch.failed < UINT16_MAX) {
+    ++batch.failed;
+  }
+}
+
+void CommandDispatcher::finish_batch() {
+  auto& batch = src_->batch_;
+  auto free = uart_->get_dma_buff().get_num_free();
+  if (batch.failed) {
+    uart_->println("Err %d: %d/%d failed, first %d", free, batch.failed, batch.total, batch.first_failed);
+  } else {
+    uart_->println("ACK %d %d", free, batch.total);
+  }
+  batch = CommandSource::batch_t{};
+}
+
+void CommandDispatcher::input_char(CommandSource& src, char c) {
+  select_source(src);
+
+  if (parser_->tick(c)) {
+    // read before running, a macro reuses the parser
+    const bool more = parser_->ended_with_separator();
+    // a macro responds once for all of its commands, like a line of several commands
+    const bool macro = get_fcn_from_cmd() == &CommandDispatcher::M2;
+    if (more || macro || src_->batch_.running) {
+      run_batched();
+      if (not more) {
+        finish_batch();
+      }
     } else {
-      send_err(free);
+      run_single();
     }
+  } else if (src_->batch_.running && StringParser::is_end_char(c) && parser_->is_waiting()) {
+    // line ended with a separator
+    finish_batch();
   }
 }
@@ -10,79 +10,57 @@
 #include <array>
 #include <optional>
 #include "uart.h"
+#include "string_parser.h"
+#include "command_macros.h"
+#include "subscriptions.h"
 
 /**
- * @brief Parses a stream of characters into commands
- * @details Can be used continuously. Upon detection of end_char (\n, \r, \0), parses the preceding characters into
- * prefix and command number. The command parameters can be queried, while processing the command. The command is stored
- * in an internal buffer.
- * An example command is: B1 C18 K0, where:
- * + prefix is B
- * + command code is 1
- * + parameter C is 18
- * + parameter K is 0
- *
+ * @brief State of one source of commands, e.g. one UART
+ * @details Each source has its own parser, response channel and batch, so sources don't interfere. Any number of
+ * sources can be served by one CommandDispatcher, and share its commands and macros.
  */
-class StringParser {
+class CommandSource {
 public:
-  /// @brief Puts the character into the buffer. If c is end_char, processes the command
-  /// @return true if c was end_char, and command is processed
-  bool tick(char c);
-
-  /// @brief Resets the state of the class
-  void reset();
-
-  /// @brief Returns the prefix of the command, or '\0'
-  char get_prefix() const {
-    return prefix_.value_or('\0');
-  }
-
-  /// @brief Returns the code of the command, or UIN16_MAX
-  uint16_t get_code() const {
-    return code_.value_or(UINT16_MAX);
-  }
-  /**
-   * @brief Get the value of a parameter or default
-   * @details Returns true if the parameter is found, even without value
-   * @param param Parameter to search
-   * @param dest where to copy the value
-   * @param def default value
-   * @return true if parameter was found
-   */
-  bool get_parameter(char param, int16_t& dest, int16_t def = 0) const;
-
-  /// @brief Command is valid, if it has a code and prefix
-  bool is_valid() const {
-    return prefix_ && code_;
+  CommandSource(UART_DMA* uart) : uart_(uart) {
   }
 
-  /// @brief pointer to the command string
-  const char* get_str() const {
-    return command_.data();
+  /// @brief The UART commands are read from, and responses are sent to
+  UART_DMA* get_uart() const {
+    return uart_;
   }
 
-  /// @returns true if @p c marks the end of a command
-  static bool is_end_char(char c);
-
 private:
-  /// @brief Parses the command into prefix and code
-  void process_command();
-
-
-  enum state_t { WAITING_START, READING_COMMAND, COMMAND_OVERFLOW };
-  state_t state_{ WAITING_START };  ///< The current state of the command reading
-
-  std::array<char, 64> command_;  ///< Command buffer
-  size_t write_index_;            ///< Write index in command buffer
-
-  std::optional<char> prefix_;    ///< Prefix of the command, if any
-  std::optional<uint16_t> code_;  ///< Code of the command, if any
+  friend class CommandDispatcher;
+
+  /// @brief State of the batch being run
+  /// @details The counters saturate at UINT16_MAX, a line of commands has no length limit
+  struct batch_t {
+    bool running{ false };       ///< A batch is being run
+    uint16_t total{ 0 };         ///< Commands run so far
+    uint16_t failed{ 0 };        ///< Number of unknown or too long commands
+    uint16_t first_failed{ 0 };  ///< 1-based index of the first failed command
+  };
+
+  UART_DMA* const uart_{ nullptr };  ///< Response channel
+  StringParser parser_;              ///< The string parser
+  batch_t batch_;                    ///< The current batch
+  bool in_macro_{ false };           ///< A macro is being run, macros can't be nested
 };
 
 
-
 /**
  * @brief Handles input from UART, and calls the correct function
+ * @details A line with a single command is acknowledged before the command is run. A line with several commands, or
+ * a macro(M2), is run as a batch, and a single aggregated response is sent once the line ends:
+ * + ACK free n, if all n commands were recognized. M2 counts as the commands of its macro, not as a command itself
+ * + Err free: failed/n failed, first k, where k is the 1-based index of the first failed command
+ *
+ * A command which doesn't fit into the buffer of the parser is not run, and fails like an unknown one.
+ *
+ * The dispatcher can serve several CommandSource objects, the commands always respond to the source being served.
+ *
+ * A source can subscribe to topics(S1), instead of polling them. Subscribed topics are checked periodically from
+ * poll_subscriptions(), and pushed to the source only when they changed.
  *
  */
 class CommandDispatcher {
@@ -95,24 +73,82 @@ public:
   void A1();    ///< set RTC time
   void A2();    ///< set alarm
   void A3();    ///< get alarm
+  void M0();    ///< list macros
+  void M1();    ///< define or append to a macro
+  void M2();    ///< run a macro
+  void M3();    ///< delete a macro
+  void S0();    ///< list subscriptions
+  void S1();    ///< subscribe to a topic
+  void S2();    ///< unsubscribe from a topic
   /// @}
 
-  CommandDispatcher(UART_DMA* uart) : uart_(uart) {
+  /// @brief Topics, that can be subscribed to with S1
+  enum topic_t : uint8_t {
+    TOPIC_TIME,         ///< RTC time and date
+    TOPIC_TEMPERATURE,  ///< RTC temperature
+    TOPIC_ALARM,        ///< State of both alarms
+    TOPIC_TASKS,        ///< Free heap and stack of tasks
+    TOPIC_COUNT,
+  };
+
+  /// @brief Dispatcher for multiple sources, use input_char(CommandSource&, char)
+  CommandDispatcher() = default;
+
+  /// @brief Dispatcher with a single source, use input_char(char)
+  CommandDispatcher(UART_DMA* uart) : default_source_(uart) {
   }
 
   /// @brief Process one character
   /// @details The actual command function is called from inside this function
-  void input_char(char c);
+  void input_char(char c) {
+    input_char(default_source_, c);
+  }
+
+  /// @brief Process one character from source @p src
+  void input_char(CommandSource& src, char c);
+
+  /**
+   * @brief Checks all due subscriptions, and pushes the values that changed to their sources
+   * @details To be called after input was processed, and whenever the returned timeout elapses.
+   * @return ticks until the next subscription is due, or portMAX_DELAY if there are none
+   */
+  TickType_t poll_subscriptions();
 
 private:
   void send_ack(int);  ///< Called, if the command is valid
   void send_err(int);  ///< Called on invalid command
 
-  UART_DMA* const uart_{ nullptr };  ///< UART dependency
+  void run_single();            ///< Runs the parsed command on its own, with ACK/Err response
+  void run_batched();           ///< Runs the parsed command as part of a batch, the response is deferred
+  void count_command(bool ok);  ///< Counts a command of the batch, as failed if not @p ok
+  void finish_batch();          ///< Sends the aggregated response of the batch
+
+  /**
+   * @brief Reads @p topic, and sends it to the current source, if sub.update() says it changed
+   * @details Implemented by the application, same as the commands.
+   * @return false if the topic couldn't be read
+   */
+  bool publish(uint8_t topic, SubscriptionTable::subscription_t& sub);
+
+  CommandSource default_source_{ nullptr };  ///< Used by input_char(char)
+  CommandSource* src_{ nullptr };            ///< The source being served
+  UART_DMA* uart_{ nullptr };                ///< Response channel of src_
+  StringParser* parser_{ nullptr };          ///< Parser of src_
 
   using cmd_fcn_ptr = void (CommandDispatcher::*)();  ///< Pointer type to own method
   cmd_fcn_ptr get_fcn_from_cmd() const;               ///< Returns the function for the current command, or nullptr
   cmd_fcn_ptr search_T_code() const;                  ///< Searches T commands only
   cmd_fcn_ptr search_A_code() const;                  ///< Searches A commands only
-  StringParser parser_;                               ///< The string parser
+  cmd_fcn_ptr search_M_code() const;                  ///< Searches M commands only
+  cmd_fcn_ptr search_S_code() const;                  ///< Searches S commands only
+
+  /// @brief Makes @p src the source being served
+  void select_source(CommandSource& src) {
+    src_ = &src;
+    uart_ = src.uart_;
+    parser_ = &src.parser_;
+  }
+
+  MacroStore macros_;                ///< User defined macros, shared by all sources
+  SubscriptionTable subscriptions_;  ///< Subscriptions of all sources
 };
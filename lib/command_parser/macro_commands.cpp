@@ -0,0 +1,99 @@
+/**
+ * @file macro_commands.cpp
+ * @brief Commands for defining and running macros
+ *
+ */
+
+#include "command_parser.h"
+
+
+void CommandDispatcher::M0() {
+  bool any = false;
+  macros_.for_each([this, &any](const char* name, const char* body) {
+    uart_->printf("%s: %s\n", name, body);
+    any = true;
+  });
+  if (not any) {
+    uart_->printf("No macros\n");
+  }
+}
+
+/**
+ * @details Parameters:
+ * "name": first string, name of the macro
+ * "body": second string, commands separated by ;
+ * A: append the body to an existing macro
+ */
+void CommandDispatcher::M1() {
+  const char *name, *body;
+  size_t name_len, body_len;
+  if (not parser_->get_string(0, name, name_len) || not parser_->get_string(1, body, body_len)) {
+    uart_->printf("Usage: M1 \"name\" \"commands\"\n");
+    return;
+  }
+
+  int16_t val;
+  const bool append = parser_->get_parameter('A', val);
+  if (not macros_.define(name, name_len, body, body_len, append)) {
+    uart_->printf("Couldn't store macro\n");
+    return;
+  }
+  uart_->printf("Macro %.*s set\n", static_cast<int>(name_len), name);
+}
+
+/**
+ * @details Parameters:
+ * "name": name of the macro to run
+ * The commands of the macro are run as a batch. If the macro is run from a batch, its commands are added to it. M2
+ * isn't counted as a command of the batch, unless the macro can't be run, then it counts as one failed command.
+ */
+void CommandDispatcher::M2() {
+  const char* name;
+  size_t name_len;
+  if (not parser_->get_string(0, name, name_len)) {
+    count_command(false);
+    uart_->printf("No macro name\n");
+    return;
+  }
+  if (src_->in_macro_) {
+    count_command(false);
+    uart_->printf("Macros can't be nested\n");
+    return;
+  }
+
+  const char* body = macros_.find(name, name_len);
+  if (not body) {
+    count_command(false);
+    uart_->printf("Unknown macro %.*s\n", static_cast<int>(name_len), name);
+    return;
+  }
+
+  // from here on the parser is reused, name is no longer valid. M2 always runs in a batch, see input_char()
+  src_->in_macro_ = true;
+  for (const char* c = body; *c; ++c) {
+    if (parser_->tick(*c)) {
+      run_batched();
+    }
+  }
+  // terminate the last command
+  if (parser_->tick(';')) {
+    run_batched();
+  }
+  src_->in_macro_ = false;
+}
+
+/**
+ * @details Parameters:
+ * "name": name of the macro to delete
+ */
+void CommandDispatcher::M3() {
+  const char* name;
+  size_t name_len;
+  if (not parser_->get_string(0, name, name_len)) {
+    uart_->printf("No macro name\n");
+    return;
+  }
+  if (not macros_.remove(name, name_len)) {
+    uart_->printf("Unknown macro %.*s\n", static_cast<int>(name_len), name);
+  }
+}
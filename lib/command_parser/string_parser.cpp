@@ -0,0 +1,169 @@
+/**
+ * @file string_parser.cpp
+ */
+
+#include "string_parser.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+/// @brief Like std::isspace, but safe for chars outside of ASCII
+static bool is_space(char c) {
+  return std::isspace(static_cast<unsigned char>(c));
+}
+
+/// @brief Like std::isdigit, but safe for chars outside of ASCII
+static bool is_digit(char c) {
+  return std::isdigit(static_cast<unsigned char>(c));
+}
+
+/**
+ * @brief Parses a decimal number like atoi(), but saturates to [@p low, @p high] instead of overflowing
+ * @details Input comes from the user, so it can't be trusted to fit in any type
+ */
+static int32_t parse_int(const char* str, int32_t low, int32_t high) {
+  while (is_space(*str)) ++str;
+
+  const bool negative = *str == '-';
+  if (*str == '-' || *str == '+') ++str;
+
+  // any value above the limit is saturated anyway, so stop growing
+  constexpr int32_t limit = 1 << 20;
+  int32_t val = 0;
+  for (; is_digit(*str); ++str) {
+    val = std::min(val * 10 + (*str - '0'), limit);
+  }
+
+  return std::clamp(negative ? -val : val, low, high);
+}
+
+bool StringParser::is_end_char(char c) {
+  return c == '\n' || c == '\r' || c == '\0';
+}
+
+bool StringParser::is_separator(char c) {
+  return c == ';';
+}
+
+bool StringParser::tick(char c) {
+  bool command_ready = false;
+  switch (state_) {
+    case WAITING_START:
+      // empty commands between separators are skipped
+      if (not is_space(c) && not is_separator(c) && not is_end_char(c)) {
+        reset();
+        write_index_ = 0;
+        command_[write_index_++] = c;
+        in_quotes_ = c == '"';
+        state_ = READING_COMMAND;
+      }
+      break;
+
+    case READING_COMMAND:
+      // the end of the command is checked first, so a full buffer doesn't swallow it
+      if (is_end_char(c) || (is_separator(c) && not in_quotes_)) {
+        state_ = WAITING_START;
+        separated_ = is_separator(c);
+        command_ready = true;
+      } else if (write_index_ == command_.size() - 1) {
+        // the last byte is kept for the terminating 0
+        state_ = COMMAND_OVERFLOW;
+        overflowed_ = true;
+      } else {
+        in_quotes_ = in_quotes_ != (c == '"');
+        command_[write_index_++] = c;
+      }
+      break;
+
+    case COMMAND_OVERFLOW:
+      // the command ends like any other, so it can be reported
+      if (is_end_char(c) || (is_separator(c) && not in_quotes_)) {
+        state_ = WAITING_START;
+        separated_ = is_separator(c);
+        command_ready = true;
+      } else {
+        in_quotes_ = in_quotes_ != (c == '"');
+      }
+      break;
+  }
+
+  if (command_ready) {
+    process_command();
+    return true;
+  } else {
+    return false;
+  }
+}
+
+void StringParser::process_command() {
+  const size_t cmd_len = strlen(command_.data());
+
+  // a truncated command must not be run
+  if (overflowed_ || cmd_len < 2) {
+    return;
+  }
+
+  const auto first = static_cast<unsigned char>(command_[0]);
+  if (std::isalpha(first)) {
+    prefix_ = std::toupper(first);
+  }
+  if (is_digit(command_[1])) {
+    code_ = parse_int(command_.data() + 1, 0, UINT16_MAX);
+  }
+}
+
+void StringParser::reset() {
+  prefix_ = std::nullopt;
+  code_ = std::nullopt;
+  write_index_ = 0;
+  in_quotes_ = false;
+  separated_ = false;
+  overflowed_ = false;
+  std::fill(command_.begin(), command_.end(), 0);
+}
+
+bool StringParser::get_parameter(char param, int16_t& dest, int16_t def) const {
+  dest = def;
+  if (!is_valid()) return false;
+  const auto end = command_.data() + strlen(command_.data());  // create crude end iterator
+  auto place = end;
+  bool quoted = false;
+  // skip first char / prefix when searching, and don't look inside strings
+  for (auto it = command_.data() + 1; it != end; ++it) {
+    if (*it == '"') {
+      quoted = not quoted;
+    } else if (not quoted && *it == param) {
+      place = it;
+      break;
+    }
+  }
+  if (place == end) return false;
+
+  if (*(place + 1) == '\0' || std::isblank(static_cast<unsigned char>(*(place + 1)))) {
+    // parameter has no value
+    return true;
+  }
+
+  dest = parse_int(place + 1, INT16_MIN, INT16_MAX);  // convert to int
+  return true;
+}
+
+bool StringParser::get_string(uint8_t n, const char*& str, size_t& len) const {
+  if (!is_valid()) return false;
+  const auto end = command_.data() + strlen(command_.data());
+  auto it = command_.data() + 1;
+
+  while (true) {
+    const auto open = std::find(it, end, '"');
+    if (open == end) return false;
+    const auto close = std::find(open + 1, end, '"');
+    if (n == 0) {
+      str = open + 1;
+      len = close - str;
+      return true;
+    }
+    if (close == end) return false;
+    --n;
+    it = close + 1;
+  }
+}
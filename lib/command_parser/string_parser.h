@@ -0,0 +1,118 @@
+/**
+ * @file string_parser.h
+ * @brief Command string parser
+ * @details Doesn't depend on HAL or FreeRTOS, so it can be built for the host, see host/string_parser
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @brief Parses a stream of characters into commands
+ * @details Can be used continuously. Upon detection of end_char (\n, \r, \0), parses the preceding characters into
+ * prefix and command number. The command parameters can be queried, while processing the command. The command is stored
+ * in an internal buffer.
+ * An example command is: B1 C18 K0, where:
+ * + prefix is B
+ * + command code is 1
+ * + parameter C is 18
+ * + parameter K is 0
+ *
+ * Several commands can be sent on one line, separated by is_separator() characters, e.g. A1 H10; A2 N0 H7. Text
+ * enclosed in double quotes is not split and is skipped when searching for parameters, so it can carry a string
+ * argument, see get_string().
+ *
+ */
+class StringParser {
+public:
+  /// @brief Puts the character into the buffer. If c is end_char, processes the command
+  /// @return true if c was end_char, and command is processed. A command which overflowed the buffer is processed too,
+  /// but is never valid, see is_overflow()
+  bool tick(char c);
+
+  /// @brief Resets the state of the class
+  void reset();
+
+  /// @brief Returns the prefix of the command, or '\0'
+  char get_prefix() const {
+    return prefix_.value_or('\0');
+  }
+
+  /// @brief Returns the code of the command, or UIN16_MAX
+  uint16_t get_code() const {
+    return code_.value_or(UINT16_MAX);
+  }
+  /**
+   * @brief Get the value of a parameter or default
+   * @details Returns true if the parameter is found, even without value
+   * @param param Parameter to search
+   * @param dest where to copy the value
+   * @param def default value
+   * @return true if parameter was found
+   */
+  bool get_parameter(char param, int16_t& dest, int16_t def = 0) const;
+
+  /// @brief Command is valid, if it has a code and prefix
+  bool is_valid() const {
+    return prefix_ && code_;
+  }
+
+  /**
+   * @brief Get the @p n th double-quoted string of the command
+   * @details The string is not terminated, an unterminated quote extends to the end of the command
+   * @param n index of the string, 0 is the first one
+   * @param str set to the first character after the opening quote
+   * @param len set to the length of the string, without the quotes
+   * @return true if the string was found
+   */
+  bool get_string(uint8_t n, const char*& str, size_t& len) const;
+
+  /// @brief pointer to the command string
+  const char* get_str() const {
+    return command_.data();
+  }
+
+  /// @brief true, if the last command was terminated by a separator, and more commands follow on the same line
+  bool ended_with_separator() const {
+    return separated_;
+  }
+
+  /// @brief true, if the last command didn't fit into the buffer, and was dropped
+  bool is_overflow() const {
+    return overflowed_;
+  }
+
+  /// @brief true, if no command is being read at the moment
+  bool is_waiting() const {
+    return state_ == WAITING_START;
+  }
+
+  /// @returns true if @p c marks the end of a command
+  static bool is_end_char(char c);
+
+  /// @returns true if @p c separates commands on the same line
+  static bool is_separator(char c);
+
+private:
+  /// @brief Parses the command into prefix and code
+  void process_command();
+
+
+  enum state_t { WAITING_START, READING_COMMAND, COMMAND_OVERFLOW };
+  state_t state_{ WAITING_START };  ///< The current state of the command reading
+
+  std::array<char, 64> command_;  ///< Command buffer, 63 characters and the terminating 0
+  size_t write_index_;            ///< Write index in command buffer
+
+  std::optional<char> prefix_;    ///< Prefix of the command, if any
+  std::optional<uint16_t> code_;  ///< Code of the command, if any
+
+  bool in_quotes_{ false };   ///< Currently reading a quoted string, separators are ignored
+  bool separated_{ false };   ///< Last command was terminated by a separator
+  bool overflowed_{ false };  ///< Last command didn't fit into command_
+};
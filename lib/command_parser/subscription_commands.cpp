@@ -0,0 +1,70 @@
+/**
+ * @file subscription_commands.cpp
+ * @brief Commands for subscribing to topics, and the periodic push of subscribed topics
+ *
+ */
+
+#include "command_parser.h"
+
+/// Subscriptions can't be checked more often than this
+static constexpr int16_t min_period_ms = 100;
+
+
+void CommandDispatcher::S0() {
+  int n = 0;
+  subscriptions_.for_each(src_, [this, &n](const SubscriptionTable::subscription_t& s) {
+    uart_->printf("Topic %d every %d ms\n", s.topic, static_cast<int>(s.period * portTICK_PERIOD_MS));
+    ++n;
+  });
+  if (not n) {
+    uart_->printf("No subscriptions\n");
+  }
+}
+
+/**
+ * @details Parameters:
+ * T: topic, see topic_t
+ * P: period in ms, at least 100. The topic is checked this often, but only pushed if it changed.
+ * The current value of the topic is pushed right away.
+ */
+void CommandDispatcher::S1() {
+  int16_t topic, period;
+  if (not parser_->get_parameter('T', topic) || not parser_->get_parameter('P', period)) {
+    uart_->printf("Usage: S1 T<topic> P<period ms>\n");
+    return;
+  }
+  if (not utils::within(topic, 0, TOPIC_COUNT - 1)) {
+    uart_->printf("Unknown topic %d\n", topic);
+    return;
+  }
+  if (period < min_period_ms) {
+    uart_->printf("Period must be at least %d ms\n", min_period_ms);
+    return;
+  }
+
+  if (not subscriptions_.subscribe(src_, topic, pdMS_TO_TICKS(period), xTaskGetTickCount())) {
+    uart_->printf("Too many subscriptions\n");
+  }
+}
+
+/**
+ * @details Parameters:
+ * T: topic to unsubscribe from. If not given, all subscriptions of the source are removed.
+ */
+void CommandDispatcher::S2() {
+  int16_t topic;
+  if (not parser_->get_parameter('T', topic)) {
+    subscriptions_.unsubscribe_all(src_);
+  } else if (not utils::within(topic, 0, UINT8_MAX) || not subscriptions_.unsubscribe(src_, topic)) {
+    uart_->printf("Not subscribed to %d\n", topic);
+  }
+}
+
+
+TickType_t CommandDispatcher::poll_subscriptions() {
+  const uint32_t wait = subscriptions_.poll(xTaskGetTickCount(), [this](SubscriptionTable::subscription_t& s) {
+    select_source(*s.src);
+    publish(s.topic, s);
+  });
+  return wait == SubscriptionTable::forever ? portMAX_DELAY : wait;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file subscriptions.cpp
+ */
+
+#include "subscriptions.h"
+
+
+bool SubscriptionTable::subscribe(CommandSource* src, uint8_t topic, uint32_t period, uint32_t now) {
+  subscription_t* slot = nullptr;
+  for (auto& s : subs_) {
+    if (s.src == src && s.topic == topic) {
+      slot = &s;
+      break;
+    }
+    if (not s.src && not slot) {
+      slot = &s;
+    }
+  }
+  if (not slot) {
+    return false;
+  }
+
+  *slot = subscription_t{ src, topic, period, now };
+  return true;
+}
+
+bool SubscriptionTable::unsubscribe(CommandSource* src, uint8_t topic) {
+  for (auto& s : subs_) {
+    if (s.src == src && s.topic == topic) {
+      s = subscription_t{};
+      return true;
+    }
+  }
+  return false;
+}
+
+int SubscriptionTable::unsubscribe_all(CommandSource* src) {
+  int n = 0;
+  for (auto& s : subs_) {
+    if (s.src == src) {
+      s = subscription_t{};
+      ++n;
+    }
+  }
+  return n;
+}
+
+uint32_t SubscriptionTable::hash(const void* data, size_t len) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < len; ++i) {
+    h = (h ^ bytes[i]) * 16777619u;
+  }
+  return h;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file subscriptions.h
+ * @brief Storage and scheduling of telemetry subscriptions
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class CommandSource;
+
+/**
+ * @brief Stores a fixed number of subscriptions, and tells which of them are due
+ * @details A subscription asks for a topic to be checked periodically, and its value to be pushed to the subscribed
+ * source whenever it changes. Whether a value changed is decided by comparing a fingerprint of the value with the one
+ * sent last, so nothing but the fingerprint has to be stored.
+ *
+ * Times are in ticks, and are compared so the tick counter may overflow.
+ */
+class SubscriptionTable {
+public:
+  static constexpr size_t max_subscriptions = 6;  ///< Number of subscriptions of all sources
+  static constexpr uint32_t forever = UINT32_MAX;  ///< Returned by poll(), if nothing is subscribed
+
+  /// One subscription, the slot is empty if src is nullptr
+  struct subscription_t {
+    CommandSource* src{ nullptr };  ///< The subscriber
+    uint8_t topic{ 0 };             ///< Topic, the meaning is up to the publisher
+    uint32_t period{ 0 };           ///< Check period in ticks
+    uint32_t due{ 0 };              ///< Tick of the next check
+    uint32_t fingerprint{ 0 };      ///< Fingerprint of the last value sent
+    bool sent{ false };             ///< A value was sent since subscribing
+
+    /// @brief Stores fingerprint @p fp of the current value. @return true if the value should be sent
+    bool update(uint32_t fp) {
+      const bool changed = not sent || fp != fingerprint;
+      fingerprint = fp;
+      sent = true;
+      return changed;
+    }
+  };
+
+  /**
+   * @brief Subscribes @p src to @p topic, the topic is checked at @p now and then every @p period ticks.
+   * @details An existing subscription of the source to the topic is replaced.
+   * @return false if the table is full
+   */
+  bool subscribe(CommandSource* src, uint8_t topic, uint32_t period, uint32_t now);
+
+  /// @brief Removes the subscription of @p src to @p topic. @return true if it existed
+  bool unsubscribe(CommandSource* src, uint8_t topic);
+
+  /// @brief Removes all subscriptions of @p src. @return number of subscriptions removed
+  int unsubscribe_all(CommandSource* src);
+
+  /**
+   * @brief Calls @p callback for each subscription due at @p now, and schedules its next check.
+   * @return ticks until the next subscription is due, or forever
+   */
+  template <class LAMBDA>
+  uint32_t poll(uint32_t now, LAMBDA&& callback) {
+    uint32_t wait = forever;
+    for (auto& s : subs_) {
+      if (not s.src) {
+        continue;
+      }
+      if (static_cast<int32_t>(s.due - now) <= 0) {
+        callback(s);
+        s.due += s.period;
+        if (static_cast<int32_t>(s.due - now) <= 0) {
+          // fell behind, don't try to catch up
+          s.due = now + s.period;
+        }
+      }
+      const uint32_t left = s.due - now;
+      if (left < wait) {
+        wait = left;
+      }
+    }
+    return wait;
+  }
+
+  /// @brief Calls @p callback for each subscription of @p src
+  template <class LAMBDA>
+  void for_each(const CommandSource* src, LAMBDA&& callback) const {
+    for (const auto& s : subs_) {
+      if (s.src && s.src == src) {
+        callback(s);
+      }
+    }
+  }
+
+  /// @brief FNV-1a hash of @p len bytes at @p data, to be used as a fingerprint
+  static uint32_t hash(const void* data, size_t len);
+
+private:
+  std::array<subscription_t, max_subscriptions> subs_{};  ///< The subscription slots
+};
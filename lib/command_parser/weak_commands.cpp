@@ -18,3 +18,8 @@ DECLARE_WEAK_COMMAND(A3);
 
 
 DECLARE_WEAK_COMMAND(T100);
+
+
+__weak bool CommandDispatcher::publish(uint8_t, SubscriptionTable::subscription_t&) {
+  return false;
+}
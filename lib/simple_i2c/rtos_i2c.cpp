@@ -0,0 +1,99 @@
+/**
+ * @file rtos_i2c.cpp
+ * @brief Asynchronous transfer of RTOS_I2C
+ */
+
+#include "rtos_i2c.h"
+
+
+bool RTOS_I2C::write_register_start(uint8_t address, uint8_t reg_addr, uint8_t* data, size_t len) {
+  utils::Lock lck(mtx_);
+  finish_transfer();
+
+  // a give left over from a timed out transfer
+  xSemaphoreTake(done_, 0);
+  transfer_ok_ = false;
+
+  if (HAL_OK != HAL_I2C_Mem_Write_DMA(&hi2c_, address, reg_addr, 1, data, len)) {
+    return false;
+  }
+  transfer_running_ = true;
+  transfer_address_ = address;
+  return true;
+}
+
+bool RTOS_I2C::finish_transfer(TickType_t timeout) {
+  if (not transfer_running_) {
+    return transfer_ok_;
+  }
+
+  transfer_running_ = false;
+  if (pdTRUE != xSemaphoreTake(done_, timeout)) {
+    recover();
+    transfer_ok_ = false;
+  }
+  if (not transfer_ok_) {
+    failed_[transfer_address_ >> 1] = true;
+  }
+  return transfer_ok_;
+}
+
+
+void RTOS_I2C::register_callbacks() {
+  HAL_I2C_RegisterCallback(&hi2c_, HAL_I2C_MEM_TX_COMPLETE_CB_ID, RTOS_I2C::transfer_cplt_cb);
+  HAL_I2C_RegisterCallback(&hi2c_, HAL_I2C_ERROR_CB_ID, RTOS_I2C::transfer_err_cb);
+}
+
+void RTOS_I2C::recover() {
+  HAL_DMA_Abort(&hdmatx_);
+  HAL_I2C_DeInit(&hi2c_);
+  HAL_I2C_Init(&hi2c_);
+  HAL_I2CEx_ConfigAnalogFilter(&hi2c_, I2C_ANALOGFILTER_ENABLE);
+  HAL_I2CEx_ConfigDigitalFilter(&hi2c_, 0x00);
+  register_callbacks();
+}
+
+
+void RTOS_I2C::transfer_cplt_cb(I2C_HandleTypeDef* hi2c) {
+  assert_param(hi2c == &i2c1_->hi2c_);
+  BaseType_t woken = pdFALSE;
+  i2c1_->transfer_ok_ = true;
+  xSemaphoreGiveFromISR(i2c1_->done_, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+void RTOS_I2C::transfer_err_cb(I2C_HandleTypeDef* hi2c) {
+  assert_param(hi2c == &i2c1_->hi2c_);
+  BaseType_t woken = pdFALSE;
+  i2c1_->transfer_ok_ = false;
+  xSemaphoreGiveFromISR(i2c1_->done_, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+
+void RTOS_I2C::i2c1_dma_init(I2C_HandleTypeDef* hi2c) {
+  RTOS_I2C& i2c = *i2c1_;
+
+  __HAL_RCC_SYSCFG_CLK_ENABLE();
+  __HAL_REMAPDMA_CHANNEL_ENABLE(HAL_REMAPDMA_I2C1_TX_DMA1_CH2);
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  i2c.hdmatx_.Instance = DMA1_Channel2;
+  i2c.hdmatx_.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  i2c.hdmatx_.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  i2c.hdmatx_.Init.MemInc = DMA_MINC_ENABLE;
+  i2c.hdmatx_.Init.Mode = DMA_NORMAL;
+  i2c.hdmatx_.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  i2c.hdmatx_.Init.PeriphInc = DMA_PINC_DISABLE;
+  i2c.hdmatx_.Init.Priority = DMA_PRIORITY_LOW;
+  HAL_DMA_Init(&i2c.hdmatx_);
+
+  __HAL_LINKDMA(hi2c, hdmatx, i2c.hdmatx_);
+
+  HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, 6, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+  HAL_NVIC_SetPriority(I2C1_EV_IRQn, 6, 0);
+  HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+  HAL_NVIC_SetPriority(I2C1_ER_IRQn, 6, 0);
+  HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+}
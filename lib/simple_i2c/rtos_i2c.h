@@ -12,6 +12,7 @@
 #include "main.h"
 #include "pin_api.h"
 #include <algorithm>
+#include <bitset>
 
 /**
  * @brief I2C hardware wrapper to be used inside and RTOS
@@ -19,7 +20,8 @@
  */
 class RTOS_I2C {
 public:
-  I2C_HandleTypeDef hi2c_;  ///< Handle to the i2c
+  I2C_HandleTypeDef hi2c_;    ///< Handle to the i2c
+  DMA_HandleTypeDef hdmatx_;  ///< Handle to the TX DMA, used by the asynchronous transfer
 
   /// Initialize the i2c1 hardware for @p i2c
   static void init_i2c1(RTOS_I2C* i2c) {
@@ -34,18 +36,22 @@ public:
 
     i2c->hi2c_.Instance = I2C1;
     i2c->hi2c_.Init = init;
+    i2c1_ = i2c;
 
     HAL_I2C_RegisterCallback(&i2c->hi2c_, HAL_I2C_MSPINIT_CB_ID, RTOS_I2C::i2c1_msp_init);
     HAL_I2C_Init(&i2c->hi2c_);
     HAL_I2CEx_ConfigAnalogFilter(&i2c->hi2c_, I2C_ANALOGFILTER_ENABLE);
     HAL_I2CEx_ConfigDigitalFilter(&i2c->hi2c_, 0x00);
+    i2c->register_callbacks();
 
 
     i2c->mtx_ = xSemaphoreCreateMutex();
+    i2c->done_ = xSemaphoreCreateBinary();
   }
 
   [[nodiscard]] bool write(uint8_t address, uint8_t* data, size_t len) {
     utils::Lock lck(mtx_);
+    finish_transfer();
     portENTER_CRITICAL();
     auto ret = HAL_I2C_Master_Transmit(&hi2c_, address, data, len, timeout_) == HAL_OK;
     portEXIT_CRITICAL();
@@ -53,6 +59,7 @@ public:
   }
   [[nodiscard]] bool read(uint8_t address, uint8_t* data, size_t len) {
     utils::Lock lck(mtx_);
+    finish_transfer();
     portENTER_CRITICAL();
     auto ret = HAL_I2C_Master_Receive(&hi2c_, address, data, len, timeout_) == HAL_OK;
     portEXIT_CRITICAL();
@@ -60,6 +67,7 @@ public:
   }
   [[nodiscard]] bool write_register(uint8_t address, uint8_t reg_addr, uint8_t* data, size_t len) {
     utils::Lock lck(mtx_);
+    finish_transfer();
     portENTER_CRITICAL();
     auto ret = HAL_I2C_Mem_Write(&hi2c_, address, reg_addr, 1, data, len, timeout_) == HAL_OK;
     portEXIT_CRITICAL();
@@ -67,20 +75,80 @@ public:
   }
   [[nodiscard]] bool read_register(uint8_t address, uint8_t reg_addr, uint8_t* data, size_t len) {
     utils::Lock lck(mtx_);
+    finish_transfer();
     portENTER_CRITICAL();
     auto ret = HAL_I2C_Mem_Read(&hi2c_, address, reg_addr, 1, data, len, timeout_) == HAL_OK;
     portEXIT_CRITICAL();
     return ret;
   }
 
-  /// If i2c bus is manipulated externally from the class, it should be locked using this object
-  [[nodiscard]] utils::Lock&& get_lock() {
-    return std::move(utils::Lock(mtx_));
+  /**
+   * @name Asynchronous transfer
+   * @details The data is written by DMA, with interrupts enabled, so long transfers don't affect the interrupt latency.
+   * The task can do other work until it calls wait_transfer(), as long as @p data isn't modified. Any other access to
+   * the bus waits for the running transfer to finish first. Only one task should use the asynchronous transfer.
+   */
+  ///@{
+  /// @brief Start writing @p len bytes from @p data to register @p reg_addr. @return false if it couldn't be started
+  [[nodiscard]] bool write_register_start(uint8_t address, uint8_t reg_addr, uint8_t* data, size_t len);
+
+  /**
+   * @brief Block until the transfer to @p address started by write_register_start() is done
+   * @details Another access may have finished the transfer already, e.g. of a second display on the bus. Failures are
+   * thus kept for each device address, until the next wait_transfer() for that address, so each device only sees its
+   * own failures, and none goes unnoticed.
+   * @return true, if no transfer to @p address failed since the last wait_transfer() for it
+   */
+  bool wait_transfer(uint8_t address, TickType_t timeout = pdMS_TO_TICKS(transfer_timeout_)) {
+    utils::Lock lck(mtx_);
+    finish_transfer(timeout);
+    const bool ok = not failed_[address >> 1];
+    failed_[address >> 1] = false;
+    return ok;
+  }
+
+  /// @brief Block until the running transfer is done, e.g. before its data is reused. Unlike wait_transfer(), a failure
+  /// isn't consumed, so it is still reported by the next wait_transfer() for its address
+  void wait_idle() {
+    utils::Lock lck(mtx_);
+    finish_transfer();
+  }
+
+  /// @brief Same as write_register(), but the task sleeps during the transfer instead of masking interrupts
+  [[nodiscard]] bool write_register_dma(uint8_t address, uint8_t reg_addr, uint8_t* data, size_t len) {
+    return write_register_start(address, reg_addr, data, len) && wait_transfer(address);
+  }
+  ///@}
+
+  /// If i2c bus is manipulated externally from the class, it should be locked using this object. A running asynchronous
+  /// transfer is finished first
+  [[nodiscard]] utils::Lock get_lock() {
+    utils::Lock lck(mtx_);
+    finish_transfer();
+    return lck;
   }
 
 private:
-  static inline constexpr uint32_t timeout_{ 100 };  ///< default timeout for I2C communication
-  SemaphoreHandle_t mtx_;                            ///< I2C mutex
+  static inline constexpr uint32_t timeout_{ 100 };           ///< default timeout for I2C communication
+  static inline constexpr uint32_t transfer_timeout_{ 200 };  ///< default timeout for asynchronous transfers in ms
+  SemaphoreHandle_t mtx_;                                     ///< I2C mutex
+  SemaphoreHandle_t done_;                                    ///< Given from ISR, once the transfer is done
+  volatile bool transfer_ok_{ false };                        ///< Result of the last transfer, set from ISR
+  bool transfer_running_{ false };                            ///< A transfer was started, and not waited for
+  uint8_t transfer_address_{ 0 };                             ///< Device address of the running transfer
+  std::bitset<128> failed_;                                   ///< 7-bit addresses of failed transfers not waited for
+
+  static inline RTOS_I2C* i2c1_{ nullptr };  ///< The object using I2C1, for the HAL callbacks
+
+  /// Wait for the running transfer, if any, mtx_ must be taken. @return result of the last transfer
+  bool finish_transfer(TickType_t timeout = pdMS_TO_TICKS(transfer_timeout_));
+  /// Register the transfer callbacks, has to be done after each HAL_I2C_Init
+  void register_callbacks();
+  /// Reset the peripheral after a transfer timed out
+  void recover();
+  /// Transfer callbacks
+  static void transfer_cplt_cb(I2C_HandleTypeDef* hi2c);
+  static void transfer_err_cb(I2C_HandleTypeDef* hi2c);
 
   /// MSP init for i2c1
   static void i2c1_msp_init(I2C_HandleTypeDef* hi2c) {
@@ -89,6 +157,10 @@ private:
       __HAL_RCC_I2C1_CLK_ENABLE();
       pin_mode(pins::sda1, pin_mode_t::ALTERNATE_OD_PU, GPIO_AF4_I2C1);
       pin_mode(pins::scl1, pin_mode_t::ALTERNATE_OD_PU, GPIO_AF4_I2C1);
+      i2c1_dma_init(hi2c);
     }
   };
+
+  /// DMA and interrupt init for i2c1, I2C1 TX is remapped to DMA channel 2, as channel 6 is used by UART2
+  static void i2c1_dma_init(I2C_HandleTypeDef* hi2c);
 };
@@ -0,0 +1,90 @@
+/**
+ * @file json_writer.cpp
+ */
+
+#include "json_writer.h"
+#include "format.h"
+
+
+JsonWriter::JsonWriter(UART_DMA& uart) : uart_(uart), lock_(uart.lock_tx()) {
+  put('{');
+}
+
+JsonWriter::~JsonWriter() {
+  put('}');
+  put('\n');
+  uart_.notify_tx();
+}
+
+JsonWriter& JsonWriter::add(const char* key, int32_t val) {
+  put_key(key);
+  put_int(val);
+  return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, const char* val) {
+  put_key(key);
+  put_string(val);
+  return *this;
+}
+
+JsonWriter& JsonWriter::add_bool(const char* key, bool val) {
+  put_key(key);
+  for (const char* c = val ? "true" : "false"; *c; ++c) {
+    put(*c);
+  }
+  return *this;
+}
+
+JsonWriter& JsonWriter::begin_object(const char* key) {
+  put_key(key);
+  put('{');
+  first_ = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::end_object() {
+  put('}');
+  first_ = false;
+  return *this;
+}
+
+void JsonWriter::put_key(const char* key) {
+  if (not first_) {
+    put(',');
+  }
+  first_ = false;
+  put_string(key);
+  put(':');
+}
+
+void JsonWriter::put_string(const char* str) {
+  static constexpr char hex[] = "0123456789abcdef";
+  put('"');
+  for (; *str; ++str) {
+    const auto c = static_cast<uint8_t>(*str);
+    if (c == '"' || c == '\\') {
+      put('\\');
+      put(c);
+    } else if (c < 0x20) {
+      // control characters as \u00XX
+      put('\\');
+      put('u');
+      put('0');
+      put('0');
+      put(hex[c >> 4]);
+      put(hex[c & 0xF]);
+    } else {
+      put(c);
+    }
+  }
+  put('"');
+}
+
+void JsonWriter::put_int(int32_t val) {
+  char digits[format::int_size];
+  const char* end = format::decimal(digits, val);
+  for (const char* c = digits; c != end; ++c) {
+    put(*c);
+  }
+}
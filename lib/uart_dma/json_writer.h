@@ -0,0 +1,52 @@
+/**
+ * @file json_writer.h
+ * @brief Streaming JSON writer for UART_DMA
+ */
+
+#pragma once
+
+#include "uart.h"
+#include <cstdint>
+
+/**
+ * @brief Writes one JSON object per line straight into the TX buffer of a UART_DMA
+ * @details The TX buffer is locked from construction until destruction, and the object is written as the members are
+ * added, in one pass and without any allocation. Numbers are written without printf. On destruction, the object is
+ * closed with a newline, so the host receives one object per line, e.g.
+ * {"cmd":"A0","hour":12,"min":5,"dow":"Monday"}
+ *
+ * Nothing else may be sent to the same UART while the writer exists, as the TX buffer is locked.
+ */
+class JsonWriter {
+public:
+  explicit JsonWriter(UART_DMA& uart);
+  ~JsonWriter();
+
+  JsonWriter(const JsonWriter&) = delete;
+  JsonWriter& operator=(const JsonWriter&) = delete;
+
+  /// @name Members
+  /// @brief Add member @p key to the current object
+  /// @{
+  JsonWriter& add(const char* key, int32_t val);
+  JsonWriter& add(const char* key, const char* val);
+  JsonWriter& add_bool(const char* key, bool val);
+  /// @}
+
+  /// @brief Start an object as member @p key, following members are added to it
+  JsonWriter& begin_object(const char* key);
+  /// @brief Close the object started by begin_object()
+  JsonWriter& end_object();
+
+private:
+  void put(char c) {
+    uart_.put_locked(c);
+  }
+  void put_key(const char* key);     ///< writes the separator and "key":
+  void put_string(const char* str);  ///< writes the string in quotes, escaped
+  void put_int(int32_t val);         ///< writes val in decimal
+
+  UART_DMA& uart_;
+  utils::Lock lock_;    ///< TX buffer lock
+  bool first_{ true };  ///< The next member is the first in the current object, no comma is needed
+};
@@ -114,6 +114,31 @@ public:
   void flush();
   ///@}
 
+  /** @name Streaming transmission
+   *  @details A message can be written in multiple parts straight into the TX buffer, without formatting it twice.
+   *  The TX buffer has to be locked with lock_tx() for the whole message, so it isn't interleaved with other messages.
+   *  The TX task is notified, once the lock is released. See JsonWriter
+   */
+  ///@{
+  /// @brief Lock the TX buffer for put_locked()
+  [[nodiscard]] utils::Lock lock_tx() {
+    return utils::Lock(tx_buff_mtx_);
+  }
+
+  /// @brief Place @p c into the TX buffer, flush if full. The buffer must be locked by the caller
+  void put_locked(uint8_t c) {
+    if (transmit_buff_.is_full()) {
+      flush();
+    }
+    transmit_buff_.push(c);  // dropped, if flush failed
+  }
+
+  /// @brief Notify the TX task, that the buffer contains data
+  void notify_tx() {
+    xTaskNotify(tx_task_, 0, eNoAction);
+  }
+  ///@}
+
   void tick();  ///< Called periodically to empty the transmit buffer
 
   void reset_buffers();  ///< Resets both buffers so head=tail=0
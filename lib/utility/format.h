@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file format.h
+ * @brief Formatting of numbers, times and dates without a format string
+ * @details Each formatter writes to @p out and returns the end of the written characters, so calls can be chained.
+ * Nothing is 0 terminated. They are constexpr, and tested at compile time below.
+ * @code
+ * char buf[16];
+ * char* end = format::hh_mm_ss(buf, t.hour, t.min, t.sec);
+ * *end = '\0';
+ * @endcode
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include "utf8.h"
+
+namespace format {
+
+  /// Longest output of decimal() without padding, a sign and 10 digits
+  inline constexpr std::size_t int_size = 11;
+
+  /// @brief Like "%*d": @p val right aligned in @p width characters, padded with @p pad
+  /// @details With @p pad '0', the zeros follow the sign, like "%0*d"
+  constexpr char* decimal(char* out, int32_t val, uint8_t width = 0, char pad = ' ') {
+    // the magnitude as unsigned, so INT32_MIN doesn't overflow
+    uint32_t mag = val < 0 ? 0u - static_cast<uint32_t>(val) : static_cast<uint32_t>(val);
+    char digits[10]{};
+    uint8_t n = 0;
+    do {
+      digits[n++] = '0' + mag % 10;
+      mag /= 10;
+    } while (mag);
+
+    int padding = width - n - (val < 0);
+    if (val < 0 && pad == '0') {
+      *out++ = '-';
+    }
+    for (; padding > 0; --padding) {
+      *out++ = pad;
+    }
+    if (val < 0 && pad != '0') {
+      *out++ = '-';
+    }
+    while (n) {
+      *out++ = digits[--n];
+    }
+    return out;
+  }
+
+  /// @brief Like "%02d" for 0-99
+  constexpr char* two_digits(char* out, uint8_t val) {
+    *out++ = '0' + val / 10;
+    *out++ = '0' + val % 10;
+    return out;
+  }
+
+  /// @brief HH:MM:SS
+  constexpr char* hh_mm_ss(char* out, uint8_t hour, uint8_t min, uint8_t sec) {
+    out = two_digits(out, hour);
+    *out++ = ':';
+    out = two_digits(out, min);
+    *out++ = ':';
+    return two_digits(out, sec);
+  }
+
+  /// @brief HH:MM
+  constexpr char* hh_mm(char* out, uint8_t hour, uint8_t min) {
+    out = two_digits(out, hour);
+    *out++ = ':';
+    return two_digits(out, min);
+  }
+
+  /// @brief Date as shown on the display, like "%d.%2d.%4d"
+  constexpr char* date(char* out, uint8_t date, uint8_t month, uint16_t year) {
+    out = decimal(out, date);
+    *out++ = '.';
+    out = decimal(out, month, 2);
+    *out++ = '.';
+    return decimal(out, year, 4);
+  }
+
+  /// @brief Fixed point number @p val / 10^@p decimals, e.g. 2175 with 2 decimals is "21.75"
+  constexpr char* fixed(char* out, int32_t val, uint8_t decimals) {
+    uint32_t scale = 1;
+    for (uint8_t i = 0; i < decimals; ++i) {
+      scale *= 10;
+    }
+    const uint32_t mag = val < 0 ? 0u - static_cast<uint32_t>(val) : static_cast<uint32_t>(val);
+    if (val < 0) {
+      *out++ = '-';
+    }
+    out = decimal(out, static_cast<int32_t>(mag / scale));
+    if (decimals) {
+      *out++ = '.';
+      out = decimal(out, static_cast<int32_t>(mag % scale), decimals, '0');
+    }
+    return out;
+  }
+
+  /// @brief At most @p max_len bytes of @p str, like "%.*s", but a UTF-8 sequence which doesn't fit is left out
+  /// @details To keep a number of characters instead, see utf8::prefix()
+  constexpr char* text(char* out, const char* str, std::size_t max_len = SIZE_MAX) {
+    char* const begin = out;
+    for (; max_len && *str; --max_len) {
+      *out++ = *str++;
+    }
+    if (utf8::is_continuation(*str)) {
+      // cut inside of a sequence, drop its first bytes
+      while (out != begin && utf8::is_continuation(*--out)) {
+      }
+    }
+    return out;
+  }
+
+
+  namespace detail {
+    /// @return true, if @p f writes exactly @p expected
+    template <class F>
+    constexpr bool writes(const char* expected, F f) {
+      char buf[32]{};
+      const char* end = f(buf);
+      const char* c = buf;
+      for (; c != end && *expected; ++c, ++expected) {
+        if (*c != *expected) {
+          return false;
+        }
+      }
+      return c == end && not *expected;
+    }
+  }  // namespace detail
+
+  static_assert(detail::writes("0", [](char* o) { return decimal(o, 0); }));
+  static_assert(detail::writes("-2147483648", [](char* o) { return decimal(o, INT32_MIN); }));
+  static_assert(detail::writes("  -5", [](char* o) { return decimal(o, -5, 4); }));
+  static_assert(detail::writes("-005", [](char* o) { return decimal(o, -5, 4, '0'); }));
+  static_assert(detail::writes("12345", [](char* o) { return decimal(o, 12345, 2); }));
+  static_assert(detail::writes("07:05:09", [](char* o) { return hh_mm_ss(o, 7, 5, 9); }));
+  static_assert(detail::writes("23:59", [](char* o) { return hh_mm(o, 23, 59); }));
+  static_assert(detail::writes("1. 5.2026", [](char* o) { return date(o, 1, 5, 2026); }));
+  static_assert(detail::writes("21.75", [](char* o) { return fixed(o, 2175, 2); }));
+  static_assert(detail::writes("-0.5", [](char* o) { return fixed(o, -5, 1); }));
+  static_assert(detail::writes("3", [](char* o) { return fixed(o, 3, 0); }));
+  static_assert(detail::writes("Mon", [](char* o) { return text(o, "Monday", 3); }));
+  static_assert(detail::writes("S", [](char* o) { return text(o, "S\xC3\xA1" "bado", 2); }));  // Sábado
+  static_assert(detail::writes("S\xC3\xA1", [](char* o) { return text(o, "S\xC3\xA1" "bado", 3); }));
+
+}  // namespace format
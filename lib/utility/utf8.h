@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file utf8.h
+ * @brief Decoding of UTF-8 text into codepoints
+ * @details Text is UTF-8 everywhere, ASCII is a single byte. Broken sequences aren't an error: a stray continuation
+ * byte or a truncated sequence is decoded as the replacement character, which no font contains, and the text goes on
+ * with the next byte. Overlong encodings aren't rejected.
+ */
+
+#include <cstdint>
+#include <cstddef>
+
+namespace utf8 {
+
+  /// Decoded in place of broken sequences
+  inline constexpr char32_t replacement = 0xFFFD;
+
+  /// @return true, if @p byte continues a sequence, instead of starting a character
+  constexpr bool is_continuation(char byte) {
+    return (static_cast<uint8_t>(byte) & 0xC0) == 0x80;
+  }
+
+  /**
+   * @brief Decodes a stream of bytes, e.g. from nanoprintf, one byte at a time
+   * @code
+   * if (decoder.feed(byte)) {
+   *   draw(decoder.codepoint());
+   * }
+   * @endcode
+   */
+  class Decoder {
+  public:
+    /// @return true, if @p byte completes a character, see codepoint()
+    constexpr bool feed(char byte) {
+      const uint8_t b = static_cast<uint8_t>(byte);
+      if (b < 0x80) {
+        // ASCII, a truncated sequence before it is dropped
+        left_ = 0;
+        codepoint_ = b;
+        return true;
+      }
+      if (is_continuation(byte)) {
+        if (left_ == 0) {
+          codepoint_ = replacement;
+          return true;
+        }
+        codepoint_ = (codepoint_ << 6) | (b & 0x3F);
+        return --left_ == 0;
+      }
+      if (b >= 0xF8) {
+        left_ = 0;
+        codepoint_ = replacement;
+        return true;
+      }
+      // lead byte, the number of its high ones is the length of the sequence
+      left_ = b >= 0xF0 ? 3 : b >= 0xE0 ? 2 : 1;
+      codepoint_ = b & (0x3F >> left_);
+      return false;
+    }
+
+    /// @return the character completed by the last feed()
+    constexpr char32_t codepoint() const {
+      return codepoint_;
+    }
+
+  private:
+    char32_t codepoint_{ 0 };  ///< Bits decoded so far
+    uint8_t left_{ 0 };        ///< Continuation bytes missing in the current sequence
+  };
+
+  /// @return the character at @p txt, which is moved to the next one. @p txt must not point to the terminating 0
+  constexpr char32_t next(const char*& txt) {
+    Decoder decoder;
+    while (not decoder.feed(*txt++)) {
+      if (not is_continuation(*txt)) {
+        // truncated, the next byte starts the next character
+        return replacement;
+      }
+    }
+    return decoder.codepoint();
+  }
+
+  /// @return bytes of the first @p chars characters of @p txt, or of the whole text if it is shorter
+  constexpr std::size_t prefix(const char* txt, std::size_t chars) {
+    const char* end = txt;
+    for (; chars && *end; --chars) {
+      next(end);
+    }
+    return end - txt;
+  }
+
+  /// @return characters in @p txt
+  constexpr std::size_t length(const char* txt) {
+    std::size_t ret = 0;
+    while (*txt) {
+      next(txt);
+      ++ret;
+    }
+    return ret;
+  }
+
+
+  namespace detail {
+    /// @return the first character of @p txt
+    constexpr char32_t first(const char* txt) {
+      return next(txt);
+    }
+  }  // namespace detail
+
+  // A, é, €, 😀
+  static_assert(detail::first("A") == 'A' && detail::first("\xC3\xA9") == 0xE9);
+  static_assert(detail::first("\xE2\x82\xAC") == 0x20AC && detail::first("\xF0\x9F\x98\x80") == 0x1F600);
+  static_assert(detail::first("\xA9") == replacement && detail::first("\xC3") == replacement);
+  static_assert(prefix("S\xC3\xA1" "bado", 3) == 4 && prefix("ab", 5) == 2);
+  static_assert(length("Mi\xC3\xA9rcoles") == 9 && length("\xC3" "A") == 2);
+
+}  // namespace utf8
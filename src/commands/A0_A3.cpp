@@ -1,18 +1,49 @@
 #include "command_parser.h"
+#include "json_writer.h"
 #include "globals.h"
 
 
+/**
+ * @file A0_A3.cpp
+ * @details Responses are sent as one JSON object per line, with the command in "cmd". On failure, the object contains
+ * the reason in "err".
+ */
 
-void CommandDispatcher::A0() {
+
+/// Send error response @p msg for command @p cmd
+static void send_json_err(UART_DMA& uart, const char* cmd, const char* msg) {
+  JsonWriter(uart).add("cmd", cmd).add("err", msg);
+}
+
+/// Send the time of the RTC as the response of command @p cmd
+static void send_time(UART_DMA& uart, const char* cmd) {
   DS3231::time t;
   if (0 != rtc.get_time(t)) {
-    uart_->printf("Err: couldn't get time\n");
+    send_json_err(uart, cmd, "couldn't get time");
     return;
   }
-  uart_->printf("Current time: ");
-  uart_->printf("%02d:%02d:%02d\n", t.hour, t.min, t.sec);
-  uart_->printf("Date: ");
-  uart_->printf("%d.%d.%d, %s\n", t.date, t.month, t.year, t.dow_str);
+
+  JsonWriter json(uart);
+  json.add("cmd", cmd).add("hour", t.hour).add("min", t.min).add("sec", t.sec);
+  json.add("date", t.date).add("month", t.month).add("year", t.year).add("dow", t.dow_str);
+}
+
+/// Send alarm @p n of the RTC as the response of command @p cmd
+static void send_alarm(UART_DMA& uart, const char* cmd, int n) {
+  DS3231::alarm_t alarm;
+  if (0 != rtc.get_alarm(n, alarm)) {
+    send_json_err(uart, cmd, "failed to get alarm");
+    return;
+  }
+
+  JsonWriter json(uart);
+  json.add("cmd", cmd).add("n", n).add("min", alarm.min).add("hour", alarm.hour);
+  json.add("type", alarm.alarm_type).add("dow", alarm.dow).add_bool("en", alarm.en);
+}
+
+
+void CommandDispatcher::A0() {
+  send_time(*uart_, "A0");
 }
 
 /**
@@ -28,13 +59,13 @@ void CommandDispatcher::A0() {
 void CommandDispatcher::A1() {
   DS3231::time t;
   if (0 != rtc.get_time(t)) {
-    uart_->printf("Err: Couldn't read time before set\n");
+    send_json_err(*uart_, "A1", "couldn't read time before set");
     return;
   }
 
   auto set_from_param = [&](auto& what, char p) {
     int16_t val;
-    if (parser_.get_parameter(p, val)) {
+    if (parser_->get_parameter(p, val)) {
       what = val;
     }
   };
@@ -48,11 +79,12 @@ void CommandDispatcher::A1() {
   set_from_param(t.dow, 'D');
 
   if (0 != rtc.set_time(t)) {
-    uart_->printf("Err: couldn't set time\n");
+    send_json_err(*uart_, "A1", "couldn't set time");
     return;
   }
 
-  A0();
+  // the new time is the response
+  send_time(*uart_, "A1");
 }
 
 
@@ -71,12 +103,12 @@ void CommandDispatcher::A2() {
 
   int16_t val{};
 
-  if (not parser_.get_parameter('N', val)) {
-    uart_->printf("No N parameter\n");
+  if (not parser_->get_parameter('N', val)) {
+    send_json_err(*uart_, "A2", "no N parameter");
     return;
   }
   if (not(val == 0 || val == 1)) {
-    uart_->printf("Invalid N\n");
+    send_json_err(*uart_, "A2", "invalid N");
     return;
   }
 
@@ -84,55 +116,49 @@ void CommandDispatcher::A2() {
 
   auto set_from_param = [&](auto& what, char p) {
     int16_t val;
-    if (parser_.get_parameter(p, val)) {
+    if (parser_->get_parameter(p, val)) {
       what = val;
     }
   };
 
   if (0 != rtc.get_alarm(n, alarm)) {
-    uart_->printf("Failed to get alarm");
+    send_json_err(*uart_, "A2", "failed to get alarm");
     return;
   }
 
   set_from_param(alarm.hour, 'H');
   set_from_param(alarm.min, 'M');
   set_from_param(alarm.dow, 'D');
-  if (parser_.get_parameter('A', val) && utils::within(val, 0, 1)) {
+  if (parser_->get_parameter('A', val) && utils::within(val, 0, 1)) {
     alarm.alarm_type = static_cast<DS3231::alarm_t::alarm_type_t>(val);
   }
   set_from_param(alarm.en, 'B');
 
   if (0 != rtc.set_alarm(n, alarm)) {
-    uart_->printf("Couldn't set alarm");
+    send_json_err(*uart_, "A2", "couldn't set alarm");
     return;
   }
 
-  uart_->printf("Alarm set!\n");
-  A3();
+  // the new state of the alarm is the response
+  send_alarm(*uart_, "A2", n);
 }
 
 
+/**
+ * @details Parameters:
+ * N: alarm number
+ */
 void CommandDispatcher::A3() {
-  DS3231::alarm_t alarm;
-
-
   int16_t val{};
 
-  if (not parser_.get_parameter('N', val)) {
-    uart_->printf("No N parameter\n");
+  if (not parser_->get_parameter('N', val)) {
+    send_json_err(*uart_, "A3", "no N parameter");
     return;
   }
   if (not(val == 0 || val == 1)) {
-    uart_->printf("Invalid N\n");
+    send_json_err(*uart_, "A3", "invalid N");
     return;
   }
 
-  const int n = val;
-
-  if (0 != rtc.get_alarm(n, alarm)) {
-    uart_->printf("Failed to get alarm %d\n", n);
-    return;
-  }
-  uart_->printf("Alarm %d: \n\tMin: %d\n\tHour: %d\n", n, alarm.min, alarm.hour);
-  uart_->printf("\tType: %d\n\tDOW: %d\n\tEn: %d\n", alarm.alarm_type, alarm.dow, alarm.en);
+  send_alarm(*uart_, "A3", val);
 }
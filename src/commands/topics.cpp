@@ -0,0 +1,127 @@
+#include "command_parser.h"
+#include "json_writer.h"
+#include "globals.h"
+#include "tasks.h"
+
+
+/**
+ * @file topics.cpp
+ * @details Values of subscribed topics are pushed as one JSON object per line, with the topic name in "sub". Only
+ * numbers are sent, so the updates stay short.
+ */
+
+
+/// Time and date
+static bool publish_time(UART_DMA& uart, SubscriptionTable::subscription_t& sub) {
+  DS3231::time t;
+  if (0 != rtc.get_time(t)) {
+    return false;
+  }
+
+  const uint8_t fields[] = { t.sec, t.min, t.hour, t.date, t.month, static_cast<uint8_t>(t.year % 100) };
+  if (sub.update(SubscriptionTable::hash(fields, sizeof(fields)))) {
+    JsonWriter json(uart);
+    json.add("sub", "time").add("hour", t.hour).add("min", t.min).add("sec", t.sec);
+    json.add("date", t.date).add("month", t.month).add("year", t.year).add("dow", t.dow);
+  }
+  return true;
+}
+
+/// Temperature in hundredths of a degree, the RTC resolution is 0.25 degrees
+static bool publish_temperature(UART_DMA& uart, SubscriptionTable::subscription_t& sub) {
+  float temp;
+  if (0 != rtc.read_temperature(temp)) {
+    return false;
+  }
+
+  const int32_t centi = static_cast<int32_t>(temp * 100);
+  if (sub.update(static_cast<uint32_t>(centi))) {
+    JsonWriter(uart).add("sub", "temp").add("c100", centi);
+  }
+  return true;
+}
+
+/// Configuration of both alarms
+static bool publish_alarms(UART_DMA& uart, SubscriptionTable::subscription_t& sub) {
+  DS3231::alarm_t alarms[2];
+  uint8_t fields[2][5];
+  for (int n = 0; n < 2; ++n) {
+    auto& a = alarms[n];
+    if (0 != rtc.get_alarm(n, a)) {
+      return false;
+    }
+    // the struct has padding, so only the values are hashed
+    fields[n][0] = a.hour;
+    fields[n][1] = a.min;
+    fields[n][2] = a.dow;
+    fields[n][3] = a.en;
+    fields[n][4] = a.alarm_type;
+  }
+
+  if (sub.update(SubscriptionTable::hash(fields, sizeof(fields)))) {
+    const char* keys[] = { "a0", "a1" };
+    JsonWriter json(uart);
+    json.add("sub", "alarm");
+    for (int n = 0; n < 2; ++n) {
+      const auto& a = alarms[n];
+      json.begin_object(keys[n]).add_bool("en", a.en).add("hour", a.hour).add("min", a.min);
+      json.add("type", a.alarm_type).add("dow", a.dow).end_object();
+    }
+  }
+  return true;
+}
+
+/// Free heap, and the minimum free stack of each task in words
+static bool publish_tasks(UART_DMA& uart, SubscriptionTable::subscription_t& sub) {
+  // fixed keys, the task names aren't unique: the tx tasks of both UARTs are "tx task"
+  const struct {
+    const char* key;
+    TaskHandle_t handle;
+  } tasks[] = {
+    { "gpio", rtos_obj::gpio_handle },
+    { "command", rtos_obj::command_handle },
+    { "ui", rtos_obj::display_handle },
+    { "uart2_tx", rtos_obj::uart2_tx_handle },
+#ifdef COMMAND_UART1
+    { "uart1_tx", rtos_obj::uart1_tx_handle },
+#endif
+#ifdef MONITOR_TASK
+    { "monitor", rtos_obj::monitor_handle },
+#endif
+  };
+  constexpr size_t num_handles = sizeof(tasks) / sizeof(tasks[0]);
+
+  uint32_t values[num_handles + 2];
+  values[0] = xPortGetFreeHeapSize();
+  values[1] = uxTaskGetNumberOfTasks();
+  for (size_t i = 0; i < num_handles; ++i) {
+    values[i + 2] = uxTaskGetStackHighWaterMark(tasks[i].handle);
+  }
+
+  if (sub.update(SubscriptionTable::hash(values, sizeof(values)))) {
+    JsonWriter json(uart);
+    json.add("sub", "tasks").add("heap", values[0]).add("n", values[1]).begin_object("stack");
+    for (size_t i = 0; i < num_handles; ++i) {
+      json.add(tasks[i].key, values[i + 2]);
+    }
+    json.end_object();
+  }
+  return true;
+}
+
+
+bool CommandDispatcher::publish(uint8_t topic, SubscriptionTable::subscription_t& sub) {
+  switch (topic) {
+    case TOPIC_TIME:
+      return publish_time(*uart_, sub);
+    case TOPIC_TEMPERATURE:
+      return publish_temperature(*uart_, sub);
+    case TOPIC_ALARM:
+      return publish_alarms(*uart_, sub);
+    case TOPIC_TASKS:
+      return publish_tasks(*uart_, sub);
+
+    default:
+      return false;
+  }
+}
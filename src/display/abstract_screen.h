@@ -4,6 +4,7 @@
 
 #pragma once
 #include <cstdint>
+#include "GFX.h"
 
 /// Abstract screen class
 class AbstractScreen {
@@ -30,10 +31,40 @@ public:
   virtual void onEncoder(int32_t inc) {
   }
 
-  /// Renders the screen, has to be implemented
+  /// Called once per frame before draw(), reads data and advances animations
+  virtual void update() {
+  }
+
+  /**
+   * @brief Renders the screen, has to be implemented
+   * @details Can be called several times per frame, once for each strip of the canvas(see GFX), so it should only
+   * draw. Anything else belongs into update().
+   */
   virtual void draw() = 0;
 
+  /// Called by the Menu, after the frame was drawn
+  void drawn() {
+    redraw_all_ = false;
+  }
+
+  /// The canvas no longer holds the last frame of this screen, the next draw() has to render everything
+  void invalidate() {
+    redraw_all_ = true;
+  }
 
   virtual ~AbstractScreen() {
   }
+
+protected:
+  /**
+   * @brief draw() has to clear the canvas and render everything, instead of only the widgets which changed
+   * @details True on the first frame of the screen, and always in page streaming mode, where the canvas doesn't keep
+   * the last frame.
+   */
+  bool redraw_all() const {
+    return redraw_all_ || GFX::buffer_pages < GFX::pages;
+  }
+
+private:
+  bool redraw_all_{ true };  ///< See redraw_all()
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @file assets.h
+ * @brief Images of the screens, see GFX::draw_image()
+ * @details Generated by create_font_data/img_to_asset.py from the images in assets/, don't edit.
+ */
+
+#include "SSD1306/image.h"
+
+namespace assets {
+
+  /// 64x56, 298 bytes instead of 448
+  inline constexpr uint16_t clock_bands[] = { 0, 46, 94, 134, 182, 212, 252, 298 };
+  inline constexpr uint8_t clock_data[] = {
+    0x82, 0x00, 0x04, 0x03, 0x07, 0x0f, 0x1f, 0x1f, 0x84, 0x3f, 0x04, 0x1f, 0x1f, 0x0f, 0x07, 0x03,
+    0x83, 0x00, 0x02, 0x01, 0x1d, 0x1d, 0x80, 0x1f, 0x02, 0x1d, 0x1d, 0x01, 0x83, 0x00, 0x04, 0x03,
+    0x07, 0x0f, 0x1f, 0x1f, 0x84, 0x3f, 0x04, 0x1f, 0x1f, 0x0f, 0x07, 0x03, 0x81, 0x00, 0x81, 0x00,
+    0x00, 0xfe, 0x85, 0xff, 0x0b, 0xfe, 0xfd, 0xfb, 0xf7, 0xef, 0xcf, 0xdf, 0xbe, 0xbc, 0x7c, 0x7b,
+    0xf8, 0x80, 0xf0, 0x81, 0xe0, 0x00, 0xef, 0x81, 0xe0, 0x80, 0xf0, 0x0b, 0xf9, 0x7b, 0x7c, 0xbc,
+    0xbe, 0xdf, 0xcf, 0xef, 0xf7, 0xfb, 0xfd, 0xfe, 0x85, 0xff, 0x00, 0xfe, 0x80, 0x00, 0x82, 0x00,
+    0x01, 0x80, 0xc0, 0x80, 0xe0, 0x08, 0xe3, 0xcf, 0x3f, 0x7f, 0xfe, 0xf8, 0xe4, 0xc6, 0x80, 0x94,
+    0x00, 0x0c, 0x01, 0x03, 0x03, 0x07, 0x87, 0xc6, 0xe4, 0xf8, 0xfe, 0x7f, 0x3f, 0xcf, 0xe3, 0x80,
+    0xe0, 0x01, 0xc0, 0x80, 0x81, 0x00, 0x86, 0x00, 0x00, 0x3f, 0x80, 0xff, 0x00, 0xc0, 0x81, 0x02,
+    0x81, 0x00, 0x08, 0x40, 0xe0, 0xf0, 0x70, 0x78, 0x38, 0x3c, 0x1e, 0x0e, 0x80, 0x0f, 0x0c, 0x0e,
+    0x1e, 0x3c, 0x38, 0x78, 0x70, 0xf0, 0xe0, 0xe0, 0xc0, 0x80, 0x80, 0x00, 0x81, 0x02, 0x00, 0xc0,
+    0x80, 0xff, 0x00, 0x3f, 0x85, 0x00, 0x86, 0x00, 0x08, 0xe0, 0xfe, 0xff, 0xff, 0x1f, 0x03, 0x00,
+    0x01, 0x01, 0x8b, 0x00, 0x00, 0x80, 0x8b, 0x00, 0x08, 0x03, 0x01, 0x00, 0x03, 0x1f, 0xff, 0xff,
+    0xfe, 0xe0, 0x85, 0x00, 0x88, 0x00, 0x0d, 0x80, 0xe0, 0xf0, 0xfc, 0xfe, 0x3f, 0x1f, 0x0f, 0x07,
+    0x03, 0x01, 0x01, 0x06, 0x04, 0x84, 0x00, 0x00, 0x07, 0x84, 0x00, 0x0d, 0x04, 0x06, 0x01, 0x01,
+    0x03, 0x07, 0x0f, 0x1f, 0x3f, 0xfe, 0xfc, 0xf0, 0xe0, 0x80, 0x87, 0x00, 0x87, 0x00, 0x0e, 0x01,
+    0x03, 0x07, 0x0e, 0x1c, 0x38, 0x70, 0xe0, 0xc0, 0xc0, 0xe0, 0xe0, 0xf0, 0xf0, 0xf8, 0x80, 0x78,
+    0x81, 0x3c, 0x00, 0xbc, 0x81, 0x3c, 0x80, 0x78, 0x0e, 0xf8, 0xf0, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0,
+    0xe0, 0x70, 0x38, 0x1c, 0x0e, 0x07, 0x03, 0x01, 0x86, 0x00,
+  };
+  inline constexpr images::Image_t clock{ 64, 56, clock_bands, clock_data };
+  static_assert(images::valid(clock));
+
+}  // namespace assets
@@ -3,10 +3,16 @@
  * @brief Global objects private to the display task
  */
 #pragma once
-#include "SSD1306.h"
+#include "display_driver.h"
 #include "GFX.h"
 #include "menu.h"
+#include "frame_scheduler.h"
 
-extern SSD1306 display;
+extern Display display;
 extern GFX gfx;
 extern Menu menu;
+extern FrameScheduler scheduler;  ///< Draws the frames of all displays
+#ifdef STATUS_DISPLAY
+extern Display status_display;  ///< Second display, at address 0x3D
+extern GFX status_gfx;
+#endif
@@ -6,13 +6,23 @@
 
 #include "FreeRTOS.h"
 #include "GFX.h"
-#include "SSD1306.h"
+#include "display_driver.h"
 #include "globals.h"
+#include "display_objects.h"
 #include "tasks.h"
 
+#include <algorithm>
+
 Menu menu;
-SSD1306 display(i2c);
+Display display(i2c);
 GFX gfx(&display);
+FrameScheduler scheduler;
+
+#ifdef STATUS_DISPLAY
+Display status_display(i2c, 0x3D);
+GFX status_gfx(&status_display);
+static StatusScreen status_screen;
+#endif
 
 
 
@@ -40,6 +50,13 @@ static void check_and_handle_alarms() {
 
 static void ui_task_init() {
   display.begin();
+#ifdef STATUS_DISPLAY
+  status_display.begin();
+#endif
+  SplashScreen splash;
+  scheduler.submit(gfx, splash);
+  scheduler.run();
+  vTaskDelay(pdMS_TO_TICKS(SplashScreen::time));
   menu.init();
 
   // clear alarm flags, if any
@@ -55,7 +72,8 @@ static void ui_task_tick() {
   static uint32_t timeout = 100;
 
   uint32_t notif = 0;
-  const BaseType_t result = xTaskNotifyWait(0, UINT32_MAX, &notif, timeout);
+  // faster while an animation runs
+  const BaseType_t result = xTaskNotifyWait(0, UINT32_MAX, &notif, std::min(timeout, menu.next_frame()));
 
 
   if (result == pdPASS) {
@@ -66,6 +84,9 @@ static void ui_task_tick() {
       // was sleeping?
       // wake up
       display.begin();
+#ifdef STATUS_DISPLAY
+      status_display.begin();
+#endif
     }
 
     ui_state = RUNNING;
@@ -84,9 +105,19 @@ static void ui_task_tick() {
     // No user input, go to sleep
     timeout = portMAX_DELAY;
     menu.sleep();
-    gfx.clear_canvas();
-    gfx.draw();
+    gfx.first_page();
+    do {
+      gfx.clear_canvas();
+    } while (gfx.next_page());
     display.sleep();
+#ifdef STATUS_DISPLAY
+    status_screen.invalidate();
+    status_gfx.first_page();
+    do {
+      status_gfx.clear_canvas();
+    } while (status_gfx.next_page());
+    status_display.sleep();
+#endif
     ui_state = SLEEPING;
   }
 
@@ -99,7 +130,14 @@ static void ui_task_tick() {
   // in running/alarm state nothing special needs to be done
 
 
+#ifdef STATUS_DISPLAY
+  if (ui_state != SLEEPING) {
+    status_screen.update();
+    scheduler.submit(status_gfx, status_screen);
+  }
+#endif
   menu.tick();
+  scheduler.run();
 }
 
 
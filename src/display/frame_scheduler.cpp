@@ -0,0 +1,57 @@
+#include "frame_scheduler.h"
+#include "main.h"
+
+#include <algorithm>
+
+
+bool FrameScheduler::submit(GFX& gfx, AbstractScreen& screen) {
+  auto slot = std::find_if(frames_.begin(), frames_.end(), [&](const Frame& f) { return f.gfx == &gfx; });
+  if (slot == frames_.end()) {
+    slot = std::find_if(frames_.begin(), frames_.end(), [](const Frame& f) { return f.gfx == nullptr; });
+  }
+  assert_param(slot != frames_.end());
+  if (slot == frames_.end()) {
+    return false;
+  }
+  *slot = { &gfx, &screen, false };
+  return true;
+}
+
+void FrameScheduler::run() {
+  const uint8_t first = first_;
+  first_ = (first_ + 1) % max_displays;
+
+  // round robin, one strip of each display with a frame left
+  bool left = pending();
+  while (left) {
+    left = false;
+    for (uint8_t i = 0; i < max_displays; ++i) {
+      Frame& frame = frames_[(first + i) % max_displays];
+      if (not frame.gfx) {
+        continue;
+      }
+      if (draw_strip(frame)) {
+        left = true;
+      } else {
+        frame = {};
+      }
+    }
+  }
+}
+
+bool FrameScheduler::pending() const {
+  return std::any_of(frames_.begin(), frames_.end(), [](const Frame& f) { return f.gfx != nullptr; });
+}
+
+bool FrameScheduler::draw_strip(Frame& frame) {
+  if (not frame.started) {
+    frame.gfx->first_page();
+    frame.started = true;
+  }
+  frame.screen->draw();
+  if (frame.gfx->next_page()) {
+    return true;
+  }
+  frame.screen->drawn();
+  return false;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file frame_scheduler.h
+ * @brief Drawing the frames of several displays on one I2C bus
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include "abstract_screen.h"
+
+/**
+ * @brief Draws the queued frames of several displays, taking turns after every strip
+ * @details Each display has its own GFX with its own canvas, and the displays share the I2C bus. A frame is drawn and
+ * sent strip by strip, like in page streaming mode(see GFX), and run() moves on to the next display after every strip.
+ * So one display never holds the bus for more than one strip, and with a whole canvas, for more than one frame. With
+ * GFX_DOUBLE_BUFFER, a frame is sent in the background while the next display draws. The display that goes first
+ * alternates from one run() to the next, so neither is always sent last.
+ *
+ * @code
+ * status_screen.update();
+ * scheduler.submit(status_gfx, status_screen);
+ * menu.tick();  // submits the current screen
+ * scheduler.run();
+ * @endcode
+ */
+class FrameScheduler {
+public:
+  static constexpr uint8_t max_displays = 2;  ///< Displays with a frame queued at the same time
+
+  /**
+   * @brief Queue a frame of @p screen on the display of @p gfx, the screen has to be updated already
+   * @details A display has only one frame queued, a newer one replaces it. @return false, if there are frames of
+   * max_displays other displays queued
+   */
+  bool submit(GFX& gfx, AbstractScreen& screen);
+
+  /// Draw and send the queued frames
+  void run();
+
+  /// @return true, if a frame is queued
+  bool pending() const;
+
+private:
+  /// A queued frame
+  struct Frame {
+    GFX* gfx{ nullptr };                ///< Display of the frame, nullptr if the slot is free
+    AbstractScreen* screen{ nullptr };  ///< Screen drawing the frame
+    bool started{ false };              ///< The first strip is drawn
+  };
+
+  /// Draw and send the next strip of @p frame. @return true, if strips are left
+  static bool draw_strip(Frame& frame);
+
+  std::array<Frame, max_displays> frames_{};  ///< Queued frames, in the order of submit()
+  uint8_t first_{ 0 };                        ///< Slot drawn first by the next run()
+};
@@ -9,31 +9,24 @@
 
 
 void MainMenuScreen::draw() {
-  gfx.clear_canvas();
-  gfx.move_cursor({ 0, 0 });
-  for (int i = 0; i < num_items; ++i) {
-    gfx.move_cursor({ 0, i });
-    if (i == current_item_) {
-      gfx.printf("*");
-    } else {
-      gfx.printf(" ");
-    }
-    gfx.printf(menu_items[i]);
+  if (redraw_all()) {
+    gfx.clear_canvas();
   }
-  gfx.draw();
+  list_.render(gfx, redraw_all());
 }
 
 void MainMenuScreen::onEncoder(int32_t increment) {
+  unsigned current_item = list_.selected();
   if (increment > 0) {
-    ++current_item_;
-  } else if (increment < 0 && current_item_) {  // do not decrement below zero
-    --current_item_;
+    ++current_item;
+  } else if (increment < 0 && current_item) {  // do not decrement below zero
+    --current_item;
   }
-  current_item_ = utils::constrain(current_item_, 0, num_items - 1);
+  list_.select(utils::constrain(current_item, 0, num_items - 1));
 }
 
 bool MainMenuScreen::onClickUp() {
-  switch (current_item_) {
+  switch (list_.selected()) {
     case 0:
       menu.goto_screen<MainScreen>();
       break;
@@ -1,5 +1,8 @@
 #include "menu.h"
 #include "globals.h"
+#include "display_objects.h"
+
+#include <algorithm>
 
 
 void Menu::init() {
@@ -13,6 +16,11 @@ void Menu::tick() {
     curr_screen_ = next_screen_;
     next_screen_ = nullptr;
     curr_screen_->onEntry();
+
+    // the new screen pushes the last one up, if the display can do it
+    if (gfx.begin_transition()) {
+      transition_.start(0, 64, transition_time, animation::Easing::OUT, HAL_GetTick());
+    }
     return;
   }
 
@@ -48,5 +56,28 @@ void Menu::tick() {
   }
 
 
-  curr_screen_->draw();
+  curr_screen_->update();
+  if (gfx.in_transition()) {
+    // the frame is only drawn into the canvas, the transition shows it
+    const uint32_t now = HAL_GetTick();
+    gfx.first_page();
+    curr_screen_->draw();
+    gfx.transition_step(transition_.value(now));
+    if (not transition_.running(now)) {
+      gfx.end_transition();
+    }
+    curr_screen_->drawn();
+    return;
+  }
+
+  // drawn by the scheduler, in turns with the other displays
+  scheduler.submit(gfx, *curr_screen_);
+}
+
+TickType_t Menu::next_frame() const {
+  if (not gfx.in_transition()) {
+    return portMAX_DELAY;
+  }
+  // the last frame is at the end of the transition
+  return pdMS_TO_TICKS(std::max<uint32_t>(transition_.next_frame(HAL_GetTick()), 1));
 }
@@ -8,6 +8,7 @@
 #include <variant>
 #include <optional>
 #include "screens.h"
+#include "animation.h"
 
 
 /**
@@ -83,10 +84,16 @@ public:
 class Menu {
 public:
   void init();  ///< Call once at the beginning
-  void tick();  ///< Call periodically to handle events and render screen
+  void tick();  ///< Call periodically to handle events, the frame of the screen is queued in the FrameScheduler
+
+  /// @brief Ticks until tick() should be called again for the next frame of an animation, portMAX_DELAY if none runs
+  TickType_t next_frame() const;
+
   /// Put Menu into sleep mode
   void sleep() {
     was_sleeping_ = true;
+    // the canvas is cleared for sleeping
+    curr_screen_->invalidate();
   }
 
   /**
@@ -102,9 +109,12 @@ public:
 
 
 private:
+  static constexpr uint32_t transition_time = 250;  ///< ms of the transition to a new screen
+
   AbstractScreen* curr_screen_;  ///< Not owning pointer to current screen
   AbstractScreen* next_screen_;  ///< Not owning pointer to next screen
   int32_t last_encoder_{ 0 };    ///< Value of encoder in last tick()
   bool held_handled_ = false;    ///< Track if held event was handled, if yes, don't call release
   bool was_sleeping_ = false;    ///< Track if menu was sleeping
+  animation::Tween transition_;  ///< Rows of the new screen shown, while GFX is in a transition
 };
@@ -1,8 +1,10 @@
 #include "screens.h"
 #include "display_objects.h"
 #include <array>
+#include <initializer_list>
 #include "globals.h"
 #include "nanoprintf.h"
+#include "assets.h"
 
 
 bool ScreenAllocator::flag_{ false };
@@ -10,52 +12,60 @@ uint8_t ScreenAllocator::storage_1_[ScreenAllocator::mem_sz];
 uint8_t ScreenAllocator::storage_2_[ScreenAllocator::mem_sz];
 
 
-void MainScreen::draw() {
-  gfx.clear_canvas();
-  gfx.move_cursor({ 0, 0 });
+void MainScreen::update() {
   DS3231::time t;
-  if (0 == rtc.get_time(t)) {
-    // length of the time string 00:00:00
-    constexpr int len = 8 * (2 + 1 + 2 + 1 + 2);
-    gfx.move_cursor({ 127 - len, 0 });
-    gfx.printf("%02d:%02d:%02d", t.hour, t.min, t.sec);
-
-    gfx.move_cursor({ 0, 1 });
-    gfx.printf("%d.%2d.%4d", t.date, t.month, t.year);
-    gfx.printf(" %.*s", 3, t.dow_str);
-  } else {
-    gfx.move_cursor({ 0, 1 });
-    gfx.printf("ERR rtc");
+  const bool time_valid = 0 == rtc.get_time(t);
+  if (time_valid) {
+    char buf[16];
+    *format::hh_mm(buf, t.hour, t.min) = '\0';
+    hour_minute_.set_text(buf);
+    buf[0] = ':';
+    *format::two_digits(buf + 1, t.sec) = '\0';
+    second_.set_text(buf);
+
+    char* end = format::date(buf, t.date, t.month, t.year);
+    *end++ = ' ';
+    *format::text(end, t.dow_str, utf8::prefix(t.dow_str, 3)) = '\0';
+    date_.set_text(buf);
+  }
+  for (widgets::Widget* w : std::initializer_list<widgets::Widget*>{ &hour_minute_, &second_, &date_ }) {
+    w->set_visible(time_valid);
   }
+  error_.set_visible(not time_valid);
 
-  float f = 0;
-  if (0 == rtc.read_temperature(f)) {
-    gfx.move_cursor({ 0, 0 });
-    gfx.printf("%d C", static_cast<int>(f));
+  float temperature;
+  const bool temperature_valid = 0 == rtc.read_temperature(temperature);
+  if (temperature_valid) {
+    temperature_.set(static_cast<int32_t>(temperature * 10));
   }
+  temperature_.set_visible(temperature_valid);
 
-  gfx.move_cursor({ 0, 3 });
   for (int i = 0; i < 2; ++i) {
+    // "Alarm 0 * 06:30" for daily alarms, the day of the week instead of the '*' otherwise
+    char buf[16];
+    char* end = format::decimal(format::text(buf, "Alarm "), i);
+    *end++ = ' ';
     DS3231::alarm_t alarm;
-    gfx.printf("Alarm %d ", i);
     if (0 == rtc.get_alarm(i, alarm)) {
-      if (alarm.en) {
-        gfx.printf("ON\n  ");
-        if (alarm.alarm_type == DS3231::alarm_t::DAILY) {
-          gfx.printf("*: ");
-        } else {
-          gfx.printf("%d: ", alarm.dow);
-        }
-        gfx.printf("%02d:%02d\n", alarm.hour, alarm.min);
+      if (not alarm.en) {
+        end = format::text(end, "OFF");
       } else {
-        gfx.printf("OFF\n");
+        end = alarm.alarm_type == DS3231::alarm_t::DAILY ? format::text(end, "*") : format::decimal(end, alarm.dow);
+        *end++ = ' ';
+        end = format::hh_mm(end, alarm.hour, alarm.min);
       }
     }
+    *end = '\0';
+    alarms_[i].set_text(buf);
   }
-
-  gfx.draw();
 }
 
+void MainScreen::draw() {
+  if (redraw_all()) {
+    gfx.clear_canvas();
+  }
+  widgets::render(gfx, redraw_all(), true, hour_minute_, second_, temperature_, date_, alarms_[0], alarms_[1], error_);
+}
 
 bool MainScreen::onClickUp() {
   menu.goto_screen<MainMenuScreen>();
@@ -63,6 +73,38 @@ bool MainScreen::onClickUp() {
 }
 
 
+void SplashScreen::draw() {
+  gfx.clear_canvas();
+  gfx.draw_image(assets::clock, { (128 - assets::clock.width_) / 2, 0 });
+  gfx.draw_text_aligned({ 0, 7 }, 128, GFX::Align::CENTER, ui_text::splash);
+}
+
+
+#ifdef STATUS_DISPLAY
+void StatusScreen::update() {
+  DS3231::time t;
+  rtc_.set_text(0 == rtc.get_time(t) ? "RTC ok" : "RTC ERR");
+
+  float temperature;
+  const bool temperature_valid = 0 == rtc.read_temperature(temperature);
+  if (temperature_valid) {
+    temperature_.set(static_cast<int32_t>(temperature * 10));
+  }
+  temperature_.set_visible(temperature_valid);
+
+  uptime_.set(HAL_GetTick() / 60000);
+  heap_.set(xPortGetFreeHeapSize());
+}
+
+void StatusScreen::draw() {
+  if (redraw_all()) {
+    status_gfx.clear_canvas();
+  }
+  widgets::render(status_gfx, redraw_all(), true, title_, rtc_, temperature_, uptime_, heap_);
+}
+#endif
+
+
 void AlarmScreen::start_beep() {
   HAL_TIM_Base_Start(&htim2);
   HAL_TIM_OC_Start(&htim2, TIM_CHANNEL_2);
@@ -103,25 +145,24 @@ bool AlarmScreen::onClickUp() {
   return true;
 }
 
-void AlarmScreen::draw() {
-  gfx.clear_canvas();
-
-  bool border = blink_flag_;
+void AlarmScreen::update() {
+  border_ = blink_flag_;
 
   if (utils::elapsed(HAL_GetTick(), next_blink_)) {
     next_blink_ = HAL_GetTick() + 500;
     blink_flag_ = not blink_flag_;
   }
 
-  gfx.draw_rectangle({ 0, 8 * 2 }, { 127, 63 }, border);
-  gfx.draw_rectangle({ 0, 0 }, { 127, 8 * 2 }, false);
+  beep_tick();
+}
+
+void AlarmScreen::draw() {
+  gfx.clear_canvas();
 
-  int len = npf_snprintf(NULL, 0, "Alarm %d", alarm_no_);
+  const bool border = border_;
 
-  int start_pos = 127 - (8 * len) * 3 / 2;
-  gfx.move_cursor({ start_pos, 0 });
-  gfx.printf("Alarm %d", alarm_no_);
+  gfx.draw_rectangle({ 0, 8 * 2 }, { 127, 63 }, border);
+  gfx.draw_rectangle({ 0, 0 }, { 127, 8 * 2 }, false);
 
-  gfx.draw();
-  beep_tick();
+  gfx.printf_aligned({ 0, 0 }, 128, GFX::Align::CENTER, "Alarm %d", alarm_no_);
 }
@@ -8,16 +8,70 @@
 #include "main.h"
 #include "abstract_screen.h"
 #include "DS3231.h"
+#include "widgets.h"
+#include "format.h"
+#include "ui_text.h"
 #include <algorithm>
 #include <type_traits>
 
 /// The default screen
 class MainScreen : public AbstractScreen {
 public:
+  MainScreen() {
+    temperature_.set_align(GFX::Align::RIGHT, 128 - second_x);
+  }
+  void update() override;  ///< Reads the RTC
   void draw() override;
   bool onClickUp() override;
+
+  /// temperature in tenths of a degree
+  static char* temperature(char* out, int32_t val) {
+    return format::text(format::fixed(out, val, 1), " C");
+  }
+
+private:
+  static constexpr uint8_t second_x = fonts::digits.text_width("00:00") + 2;
+
+  // large HH:MM on the top 4 lines, seconds next to it on the bottom line of the digits. Only the digits which changed
+  // are drawn again, usually the last digit of the seconds
+  widgets::Cells<6> hour_minute_{ 0, 0, fonts::digits };
+  widgets::Cells<4> second_{ second_x, 3 };
+  widgets::Number temperature_{ second_x, 0, temperature };  ///< right aligned, next to the digits
+  widgets::Text<16> date_{ 0, 4 };
+  widgets::Text<16> alarms_[2]{ { 0, 6 }, { 0, 7 } };
+  widgets::Label error_{ 0, 1, "ERR rtc" };
+};
+
+/// Shown once while the clock starts, see assets.h
+class SplashScreen : public AbstractScreen {
+public:
+  static constexpr uint32_t time = 1000;  ///< ms the splash is shown
+  void draw() override;
 };
 
+#ifdef STATUS_DISPLAY
+/// State of the clock on the second display, it has no input
+class StatusScreen : public AbstractScreen {
+public:
+  void update() override;  ///< Reads the RTC and the state of the system
+  void draw() override;
+
+private:
+  /// "Up 3d 04:05" from @p minutes of uptime
+  static char* uptime(char* out, int32_t minutes) {
+    out = format::decimal(format::text(out, "Up "), minutes / (24 * 60));
+    out = format::text(out, "d ");
+    return format::hh_mm(out, minutes / 60 % 24, minutes % 60);
+  }
+
+  widgets::Label title_{ 0, 0, "Status" };
+  widgets::Label rtc_{ 0, 2, "RTC ok" };
+  widgets::Number temperature_{ 0, 3, MainScreen::temperature };
+  widgets::Number uptime_{ 0, 5, uptime };
+  widgets::Number heap_{ 0, 6, "Heap %d B" };
+};
+#endif
+
 /// Main menu
 class MainMenuScreen : public AbstractScreen {
 public:
@@ -26,10 +80,9 @@ public:
   bool onClickUp() override;
 
 private:
-  static constexpr const char* menu_items[] = { "Back", "Set alarm 1", "Set alarm 2", "Alarm" };
-  static constexpr unsigned num_items = sizeof(menu_items) / sizeof(menu_items[0]);
+  static constexpr unsigned num_items = sizeof(ui_text::menu_items) / sizeof(ui_text::menu_items[0]);
 
-  unsigned current_item_ = 0;
+  widgets::List list_{ 0, 0, ui_text::menu_items, num_items };  ///< the selected item is the current one
 };
 
 /// Example screen
@@ -37,9 +90,11 @@ class SetAlarmScreen : public AbstractScreen {
 public:
   SetAlarmScreen(int n) : alarm_no_(n) {
     next_blink_ = HAL_GetTick() + 1000;
+    title_.set(n);
   }
   void onEntry() override;
   void onExit() override;
+  void update() override;  ///< Blinks the edited value
   void draw() override;
   bool onClickDown() override;
   bool onClickUp() override;
@@ -57,6 +112,18 @@ private:
   bool blink_on_ = true;         ///< blink state while editing
   uint32_t next_blink_ = 0;      ///< time to change blink_
   bool held_released_ = true;    ///< so holding the button doesn't skip settings
+
+  // default format is:
+  // %d: %2d:%2d->%d, DOW, hour, minute, en
+  widgets::Number title_{ 0, 0, "Alarm: %d" };
+  widgets::Label error_{ 0, 2, "Couldn't get alarm" };
+  widgets::Number dow_{ 0, 2, "%d" };
+  widgets::Label dow_colon_{ 8, 2, ": " };
+  widgets::Number hour_{ 24, 2, "%02d" };
+  widgets::Label hour_colon_{ 40, 2, ":" };
+  widgets::Number minute_{ 48, 2, "%02d" };
+  widgets::Label arrow_{ 64, 2, "->" };
+  widgets::Label en_{ 80, 2, "OFF" };
 };
 
 
@@ -67,6 +134,7 @@ public:
   }
   void onEntry() override;    ///< start blinking of LED
   void onExit() override;     ///< stop blinking of LED
+  void update() override;     ///< blinks and beeps
   void draw() override;       ///< blinking alarm screen
   bool onClickUp() override;  ///< end alarm
 
@@ -76,6 +144,7 @@ private:
   void stop_beep();   ///< Disable timer
 
   bool blink_flag_ = false;
+  bool border_ = false;  ///< border drawn in this frame
   uint32_t next_blink_ = 0;
   uint32_t next_beep_ = 0;
   bool beep_state_ = true;
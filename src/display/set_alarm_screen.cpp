@@ -1,6 +1,7 @@
 #include "screens.h"
 #include "../globals.h"
 #include "display_objects.h"
+#include <initializer_list>
 
 
 void SetAlarmScreen::onEntry() {
@@ -15,58 +16,36 @@ void SetAlarmScreen::onExit() {
 }
 
 
-void SetAlarmScreen::draw() {
+void SetAlarmScreen::update() {
   if (utils::elapsed(HAL_GetTick(), next_blink_)) {
     next_blink_ = HAL_GetTick() + 1000;
     blink_on_ = not blink_on_;
   }
 
-  gfx.clear_canvas();
-  gfx.printf("Alarm: %d", alarm_no_);
-
-
-  if (not valid_) {
-    gfx.printf("\n\nCouldn't get alarm");
-    return;
-  }
-
-  gfx.move_cursor({ 0, 2 });
-
-  // default format is:
-  // %d: %2d:%2d->%d, DOW, hour, minute, en
-
-
   const int dow_num = alarm_.alarm_type == DS3231::alarm_t::DAILY ? 0 : alarm_.dow;
-  if (editing_dow_ && !blink_on_) {
-    gfx.printf(" : ");
-  } else {
-    gfx.printf("%d: ", dow_num);
-  }
-
-  if (editing_hour_ && !blink_on_) {
-    gfx.printf("  :");
-  } else {
-    gfx.printf("%02d:", alarm_.hour);
-  }
-
-  if (editing_minute_ && !blink_on_) {
-    gfx.printf("  ");
-  } else {
-    gfx.printf("%02d", alarm_.min);
+  dow_.set(dow_num);
+  hour_.set(alarm_.hour);
+  minute_.set(alarm_.min);
+  en_.set_text(alarm_.en ? "ON" : "OFF");
+
+  dow_.set_blink(editing_dow_);
+  hour_.set_blink(editing_hour_);
+  minute_.set_blink(editing_minute_);
+  en_.set_blink(editing_en_);
+
+  for (widgets::Widget* w :
+       std::initializer_list<widgets::Widget*>{ &dow_, &dow_colon_, &hour_, &hour_colon_, &minute_, &arrow_, &en_ }) {
+    w->set_visible(valid_);
   }
+  error_.set_visible(not valid_);
+}
 
-  gfx.printf("->");
-
-  if (editing_en_ && !blink_on_) {
-  } else {
-    if (alarm_.en) {
-      gfx.printf("ON");
-    } else {
-      gfx.printf("OFF");
-    }
+void SetAlarmScreen::draw() {
+  if (redraw_all()) {
+    gfx.clear_canvas();
   }
-
-  gfx.draw();
+  widgets::render(gfx, redraw_all(), blink_on_, title_, error_, dow_, dow_colon_, hour_, hour_colon_, minute_, arrow_,
+                  en_);
 }
 
 
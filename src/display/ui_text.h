@@ -0,0 +1,36 @@
+/**
+ * @file ui_text.h
+ * @brief Text of the screens, in the language picked by a build flag, English by default
+ * @details Text is UTF-8. Characters outside of ASCII need a glyph in font1, which create_font_data/subset_font.py
+ * generates for the characters used in the sources, and which is checked below. The names of the days come from
+ * DS3231::dow_to_str().
+ */
+
+#pragma once
+#include <cstddef>
+#include "SSD1306/fonts.h"
+
+namespace ui_text {
+
+#ifdef LANGUAGE_ES
+  inline constexpr const char* menu_items[] = { "Atrás", "Fijar alarma 1", "Fijar alarma 2", "Alarma" };
+  inline constexpr const char* splash = "Despertador";
+#else
+  inline constexpr const char* menu_items[] = { "Back", "Set alarm 1", "Set alarm 2", "Alarm" };
+  inline constexpr const char* splash = "Alarm clock";
+#endif
+
+  /// @return true, if font1 has the glyphs of all @p items
+  template <std::size_t N>
+  constexpr bool in_font1(const char* const (&items)[N]) {
+    for (const char* item : items) {
+      if (not fonts::font1.covers(item)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static_assert(in_font1(menu_items) && fonts::font1.covers(splash), "run create_font_data/subset_font.py");
+
+}  // namespace ui_text
@@ -6,7 +6,7 @@
 #include "uart.h"
 #include "rtos_i2c.h"
 #include "DS3231.h"
-#include "SSD1306.h"
+#include "display_driver.h"
 #include "GFX.h"
 #include "command_parser.h"
 #include "encoder.h"
@@ -14,6 +14,9 @@
 #include "display/menu.h"
 
 extern UART_DMA uart2;           ///< Uart for communication with PC
+#ifdef COMMAND_UART1
+extern UART_DMA uart1;  ///< Uart for communication with a companion MCU
+#endif
 extern RTOS_I2C i2c;             ///< I2C bus with the RTC and OLED
 extern DS3231 rtc;               ///< RTC
 extern TIM_HandleTypeDef htim7;  ///< HAL tick timer
@@ -23,6 +23,9 @@
 /// @{
 
 UART_DMA uart2(UART_DMA::uart2_hw_init, UART_DMA::uart2_enable_isrs);
+#ifdef COMMAND_UART1
+UART_DMA uart1(UART_DMA::uart1_hw_init, UART_DMA::uart1_enable_isrs);
+#endif
 RTOS_I2C i2c;
 DS3231 rtc(i2c);
 RotaryEncoder encoder;
@@ -36,6 +39,9 @@ int main(void) {
 
   /// initialize global hardware objects
   uart2.hw_init(115200);
+#ifdef COMMAND_UART1
+  uart1.hw_init(115200);
+#endif
   RTOS_I2C::init_i2c1(&i2c);
 
   TIM2_Init_1kHz();
@@ -64,6 +70,9 @@ int main(void) {
   rtos_obj::gpio_queue = xQueueCreate(10, sizeof(GPIOStateContainer));
 
   uart2.begin(&rtos_obj::uart2_tx_handle);
+#ifdef COMMAND_UART1
+  uart1.begin(&rtos_obj::uart1_tx_handle);
+#endif
   xTaskCreate(rtos_tasks::gpio_task, "GPIO task", 128, nullptr, 20, &rtos_obj::gpio_handle);
   xTaskCreate(rtos_tasks::command_task, "Command task", 128, nullptr, 20, &rtos_obj::command_handle);
   xTaskCreate(rtos_tasks::ui_task, "UI task", 150, nullptr, 20, &rtos_obj::display_handle);
@@ -72,6 +81,9 @@ int main(void) {
 #endif
 
   uart2.register_task_to_notify_on_rx(rtos_obj::command_handle);
+#ifdef COMMAND_UART1
+  uart1.register_task_to_notify_on_rx(rtos_obj::command_handle);
+#endif
 
 
   /// Start the scheduler
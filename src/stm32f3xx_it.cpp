@@ -68,6 +68,32 @@ void USART2_IRQHandler(void) {
   HAL_UART_IRQHandler(&uart2.huart_);
 }
 
+void DMA1_Channel2_IRQHandler(void) {
+  HAL_DMA_IRQHandler(&i2c.hdmatx_);
+}
+
+void I2C1_EV_IRQHandler(void) {
+  HAL_I2C_EV_IRQHandler(&i2c.hi2c_);
+}
+
+void I2C1_ER_IRQHandler(void) {
+  HAL_I2C_ER_IRQHandler(&i2c.hi2c_);
+}
+
+#ifdef COMMAND_UART1
+void DMA1_Channel4_IRQHandler(void) {
+  HAL_DMA_IRQHandler(&uart1.hdmatx_);
+}
+
+void DMA1_Channel5_IRQHandler(void) {
+  HAL_DMA_IRQHandler(&uart1.hdmarx_);
+}
+
+void USART1_IRQHandler(void) {
+  HAL_UART_IRQHandler(&uart1.huart_);
+}
+#endif
+
 void TIM7_DAC2_IRQHandler(void) {
   extern TIM_HandleTypeDef htim7;
   HAL_TIM_IRQHandler(&htim7);
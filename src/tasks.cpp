@@ -22,18 +22,37 @@ namespace rtos_obj {
   TaskHandle_t monitor_handle;
 #endif
   TaskHandle_t uart2_tx_handle;
+#ifdef COMMAND_UART1
+  TaskHandle_t uart1_tx_handle;
+#endif
 };  // namespace rtos_obj
 
 
 
 void rtos_tasks::command_task(void*) {
-  static CommandDispatcher cmd(&uart2);
+  /// All sources share the commands and macros of one dispatcher
+  static CommandDispatcher cmd;
+  static CommandSource sources[] = {
+    CommandSource(&uart2),
+#ifdef COMMAND_UART1
+    CommandSource(&uart1),
+#endif
+  };
+
+  // woken up by input, or when the next subscription is due
+  TickType_t timeout = portMAX_DELAY;
   while (1) {
-    xTaskNotifyWait(0, UINT32_MAX, nullptr, portMAX_DELAY);
+    xTaskNotifyWait(0, UINT32_MAX, nullptr, timeout);
 
-    while (uart2.available()) {
-      cmd.input_char(uart2.get_one());
+    // every UART notifies this task, so serve all of them
+    for (auto& src : sources) {
+      UART_DMA& uart = *src.get_uart();
+      while (uart.available()) {
+        cmd.input_char(src, uart.get_one());
+      }
     }
+
+    timeout = cmd.poll_subscriptions();
   }
 }
 
@@ -94,6 +113,10 @@ void rtos_tasks::monitor_task(void*) {
 
   /// Dynamic allocation of space for status of all tasks
   auto statuses = static_cast<TaskStatus_t*>(pvPortMalloc(num_of_tasks * sizeof(TaskStatus_t)));
+  if (not statuses) {
+    uart2.printf("\tMEM_WARN: HEAP : no space for the monitor\n");
+    vTaskDelete(nullptr);
+  }
 
   /// if task stack is ever lower than this many bytes, a warning is generated
   constexpr size_t memory_low_th{ 20 };
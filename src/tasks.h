@@ -16,7 +16,7 @@ namespace rtos_tasks {
   /// Handle GPIO events. Events are received in a Queue
   void gpio_task(void*);
 
-  /// Handle UART commands
+  /// Handle commands from all UARTs
   void command_task(void*);
 
   /// Draw display
@@ -39,6 +39,9 @@ namespace rtos_obj {
   extern TaskHandle_t monitor_handle;  ///< Memory monitor task handle
 #endif
   extern TaskHandle_t uart2_tx_handle;  ///< UART2 tx task handle
+#ifdef COMMAND_UART1
+  extern TaskHandle_t uart1_tx_handle;  ///< UART1 tx task handle
+#endif
 
 
   enum gpio_notification_flags : uint32_t {
@@ -17,14 +17,30 @@ void CommandDispatcher::T100() {
 }
 
 
+static int publish_cnt = 0;
+static uint32_t topic_val = 0;
+static int pushed_cnt = 0;
+
+/// test topic, changes every 4th check
+bool CommandDispatcher::publish(uint8_t, SubscriptionTable::subscription_t& sub) {
+  if (sub.update(topic_val++ / 4)) {
+    ++pushed_cnt;
+  }
+  ++publish_cnt;
+  return true;
+}
+
+
 TaskHandle_t uart_handle;
 static void uart_task(void*) {
+  TickType_t timeout = portMAX_DELAY;
   while (1) {
-    xTaskNotifyWait(0, UINT32_MAX, nullptr, portMAX_DELAY);
+    xTaskNotifyWait(0, UINT32_MAX, nullptr, timeout);
 
     while (uart1.available()) {
       cmd.input_char(uart1.get_one());
     }
+    timeout = cmd.poll_subscriptions();
   }
 }
 
@@ -46,11 +62,52 @@ void test_command_called() {
   TEST_ASSERT_EQUAL(1, glob_val);
 }
 
+/// Test if all commands of a line are called
+void test_batch_called() {
+  glob_val = 0;
+  uart1.printf("T100; T100;T100\n");
+  vTaskDelay(pdMS_TO_TICKS(200));
+  TEST_ASSERT_EQUAL(3, glob_val);
+}
+
+/// Test if a stored macro calls its commands
+void test_macro_called() {
+  glob_val = 0;
+  uart1.printf("M1 \"t\" \"T100;T100\"\n");
+  vTaskDelay(pdMS_TO_TICKS(200));
+  uart1.printf("M2 \"t\"\n");
+  vTaskDelay(pdMS_TO_TICKS(200));
+  TEST_ASSERT_EQUAL(2, glob_val);
+}
+
+/// Test if a subscribed topic is checked periodically, and pushed only on change
+void test_subscription_pushed() {
+  publish_cnt = 0;
+  pushed_cnt = 0;
+  topic_val = 0;
+  uart1.printf("S1 T0 P100\n");
+  vTaskDelay(pdMS_TO_TICKS(1050));
+  uart1.printf("S2 T0\n");
+  vTaskDelay(pdMS_TO_TICKS(200));
+
+  // checked right away, and every 100 ms after that
+  TEST_ASSERT_INT_WITHIN(1, 11, publish_cnt);
+  TEST_ASSERT_EQUAL((publish_cnt + 3) / 4, pushed_cnt);
+
+  // no more checks after unsubscribing
+  const int cnt = publish_cnt;
+  vTaskDelay(pdMS_TO_TICKS(300));
+  TEST_ASSERT_EQUAL(cnt, publish_cnt);
+}
+
 
 void test_task(void*) {
   UNITY_BEGIN();
 
   RUN_TEST(test_command_called);
+  RUN_TEST(test_batch_called);
+  RUN_TEST(test_macro_called);
+  RUN_TEST(test_subscription_pushed);
 
   UNITY_END();
 
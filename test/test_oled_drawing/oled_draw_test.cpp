@@ -5,11 +5,14 @@
 #include "GFX.h"
 #include <unity.h>
 #include "rtos_i2c.h"
-#include "SSD1306.h"
+#include "display_driver.h"
+#include "widgets.h"
 
 static RTOS_I2C i2c;
-static SSD1306 display(i2c);
+static Display display(i2c);
 static GFX gfx(&display);
+/// Canvas without a display, for comparing with a full redraw. Static, as it doesn't fit on the stack of the test task
+static GFX full(nullptr);
 
 void setUp() {
   gfx.clear_canvas();
@@ -42,6 +45,89 @@ void test_draw_rectangle() {
   }
 }
 
+/// Test filled circle against the distance from the center
+void test_draw_circle() {
+  const Pixel center{ 30, 20 };
+  const int radius = 13;
+  gfx.draw_circle(center, radius);
+  gfx.draw();
+
+  for (int x = 0; x < 128; ++x) {
+    for (int y = 0; y < 64; ++y) {
+      TEST_ASSERT_EQUAL(center.distance({ x, y }) <= radius, gfx.get_pixel({ x, y }));
+    }
+  }
+}
+
+/// Test line end points and pixel count
+void test_draw_line() {
+  gfx.draw_line({ 0, 0 }, { 127, 63 });
+  gfx.draw();
+
+  int cnt = 0;
+  for (int x = 0; x < 128; ++x) {
+    for (int y = 0; y < 64; ++y) {
+      cnt += gfx.get_pixel({ x, y });
+    }
+  }
+  TEST_ASSERT_EQUAL(128, cnt);
+  TEST_ASSERT_TRUE(gfx.get_pixel({ 0, 0 }));
+  TEST_ASSERT_TRUE(gfx.get_pixel({ 127, 63 }));
+}
+
+/// Test copy of a region, and inverting it
+void test_blit() {
+  gfx.draw_rectangle({ 2, 3 }, { 9, 12 });
+  gfx.blit({ 0, 0 }, { 15, 15 }, { 50, 37 });
+  gfx.invert_rect({ 50, 37 }, { 65, 52 });
+  gfx.draw();
+
+  for (int x = 0; x < 16; ++x) {
+    for (int y = 0; y < 16; ++y) {
+      TEST_ASSERT_EQUAL(not gfx.get_pixel({ x, y }), gfx.get_pixel({ x + 50, y + 37 }));
+    }
+  }
+}
+
+/// Test drawing is translated into the viewport and clipped, instead of smeared onto the edges
+void test_viewport_clip() {
+  gfx.clear_canvas();
+  gfx.set_pixel({ 200, 10 });
+  gfx.draw_rectangle({ 120, 20 }, { 140, 21 });
+  TEST_ASSERT_FALSE(gfx.get_pixel({ 127, 10 }));
+  TEST_ASSERT_TRUE(gfx.get_pixel({ 127, 20 }));
+
+  gfx.set_viewport({ 10, 10 }, { 19, 19 });
+  gfx.draw_rectangle({ -5, -5 }, { 20, 20 });
+  gfx.reset_viewport();
+  for (int x = 0; x < 30; ++x) {
+    for (int y = 0; y < 30; ++y) {
+      TEST_ASSERT_EQUAL(utils::within(x, 10, 19) && utils::within(y, 10, 19), gfx.get_pixel({ x, y }));
+    }
+  }
+  gfx.draw();
+}
+
+/// Test a compressed image is decoded into the canvas at an unaligned position
+void test_draw_image() {
+  // 4x10: a literal 0xFF, 0x81 repeated twice and a literal 0x01, the second band only has the top two rows
+  static constexpr uint16_t bands[] = { 0, 6, 8 };
+  static constexpr uint8_t data[] = { 0x00, 0xFF, 0x80, 0x81, 0x00, 0x01, 0x82, 0xC0 };
+  static constexpr images::Image_t image{ 4, 10, bands, data };
+  static_assert(images::valid(image));
+
+  gfx.draw_image(image, { 30, 21 });
+  for (int x = 0; x < 4; ++x) {
+    for (int y = 0; y < 10; ++y) {
+      const bool lit = y >= 8 || (x == 0 ? true : x == 3 ? y == 7 : y == 0 || y == 7);
+      TEST_ASSERT_EQUAL(lit, gfx.get_pixel({ x + 30, y + 21 }));
+    }
+  }
+  TEST_ASSERT_FALSE(gfx.get_pixel({ 30, 20 }));
+  TEST_ASSERT_FALSE(gfx.get_pixel({ 30, 31 }));
+  gfx.draw();
+}
+
 /// Test simple text rendering
 void test_draw_text() {
   const char* txt = "Hello world!";
@@ -51,6 +137,120 @@ void test_draw_text() {
   gfx.draw();
 }
 
+/// Test a glyph off the page boundary matches the aligned one
+void test_draw_char_unaligned() {
+  gfx.clear_canvas();
+  gfx.render_glyph({ 0, 1 }, 'A');
+  gfx.draw_char({ 20, 13 }, 'A');
+  gfx.draw();
+
+  for (int x = 0; x < 8; ++x) {
+    for (int y = 0; y < 8; ++y) {
+      TEST_ASSERT_EQUAL(gfx.get_pixel({ x, y + 8 }), gfx.get_pixel({ x + 20, y + 13 }));
+    }
+  }
+}
+
+/// Test a multi page proportional font
+void test_draw_large_digits() {
+  gfx.clear_canvas();
+  gfx.set_font(fonts::digits);
+  TEST_ASSERT_EQUAL(fonts::digits.glyph_width(':') + fonts::digits.spacing_, gfx.draw_char({ 0, 0 }, ':'));
+  gfx.move_cursor({ 10, 0 });
+  gfx.printf("%d", 8);
+  gfx.draw_char({ 40, 27 }, '8');
+  gfx.set_font(fonts::font1);
+  gfx.draw();
+
+  for (int x = 0; x < fonts::digits.glyph_width('8'); ++x) {
+    for (int y = 0; y < fonts::digits.height(); ++y) {
+      TEST_ASSERT_EQUAL(gfx.get_pixel({ x + 10, y }), gfx.get_pixel({ x + 40, y + 27 }));
+    }
+  }
+}
+
+/// Test aligned, truncated and wrapped text
+void test_text_layout() {
+  gfx.clear_canvas();
+  TEST_ASSERT_EQUAL(5 * 8, gfx.text_width("Hello"));
+  TEST_ASSERT_EQUAL(5 * 8, gfx.draw_text_aligned({ 0, 0 }, 128, GFX::Align::RIGHT, "Hello"));
+  TEST_ASSERT_TRUE(gfx.get_pixel({ 127 - 5 * 8 + 1, 1 }) || gfx.get_pixel({ 127 - 5 * 8 + 2, 1 }));
+
+  // "Hel..." in 48 pixels
+  TEST_ASSERT_EQUAL(6 * 8, gfx.printf_aligned({ 0, 1 }, 48, GFX::Align::CENTER, "%s world", "Hello"));
+  TEST_ASSERT_EQUAL(3, gfx.draw_text_wrapped({ 0, 2 }, 48, 4, "one two three"));
+  TEST_ASSERT_EQUAL(2, gfx.draw_text_wrapped({ 0, 5 }, 128, 2, "a\nb\nc"));
+  gfx.draw();
+}
+
+/// Test a widget only redrawn on change leaves the same canvas as a full redraw
+void test_widget_redraw() {
+  widgets::Number number{ 10, 1, "%d" };
+  number.set(1234);
+  number.render(gfx, true);
+  number.set(7);
+  number.render(gfx, false);
+  gfx.draw();
+
+  full.clear_canvas();
+  widgets::Number reference{ 10, 1, "%d" };
+  reference.set(7);
+  reference.render(full, true);
+  for (int x = 0; x < 128; ++x) {
+    for (int y = 0; y < 24; ++y) {
+      TEST_ASSERT_EQUAL(full.get_pixel({ x, y }), gfx.get_pixel({ x, y }));
+    }
+  }
+}
+
+/// Test only the changed cells are drawn again, and the result matches a full redraw
+void test_cells_redraw() {
+  gfx.clear_canvas();
+  widgets::Cells<6> cells{ 0, 0, fonts::digits };
+  cells.set_text("12:59");
+  cells.render(gfx, true);
+
+  // a pixel in the blank corner of the '1' stays, as its cell isn't drawn again
+  gfx.set_pixel({ 0, 0 });
+  cells.set_text("12:50");
+  cells.render(gfx, false);
+  TEST_ASSERT_TRUE(gfx.get_pixel({ 0, 0 }));
+  gfx.reset_pixel({ 0, 0 });
+  gfx.draw();
+
+  full.clear_canvas();
+  widgets::Cells<6> reference{ 0, 0, fonts::digits };
+  reference.set_text("12:50");
+  reference.render(full, true);
+  for (int x = 0; x < 128; ++x) {
+    for (int y = 0; y < fonts::digits.height(); ++y) {
+      TEST_ASSERT_EQUAL(full.get_pixel({ x, y }), gfx.get_pixel({ x, y }));
+    }
+  }
+}
+
+/// Test UTF-8 text: 'á' is a glyph after ASCII, printf gets it byte by byte, a missing 'ñ' is skipped like a space
+void test_draw_utf8() {
+  gfx.clear_canvas();
+  gfx.draw_char({ 0, 0 }, 0xE1);
+  TEST_ASSERT_NOT_NULL(gfx.font().glyph(0xE1));
+  TEST_ASSERT_EQUAL(3 * 8, gfx.text_width("a\xC3\xB1o"));
+
+  gfx.move_cursor({ 0, 2 });
+  gfx.draw_text("\xC3\xB1\xC3\xA1");
+  gfx.move_cursor({ 0, 4 });
+  gfx.printf("%s", "\xC3\xB1\xC3\xA1");
+  gfx.draw();
+
+  for (int x = 0; x < 8; ++x) {
+    for (int y = 0; y < 8; ++y) {
+      TEST_ASSERT_EQUAL(gfx.get_pixel({ x, y }), gfx.get_pixel({ x + 8, y + 16 }));
+      TEST_ASSERT_EQUAL(gfx.get_pixel({ x, y }), gfx.get_pixel({ x + 8, y + 32 }));
+      TEST_ASSERT_FALSE(gfx.get_pixel({ x, y + 16 }));
+    }
+  }
+}
+
 /// Test printf method
 void test_printf() {
   char fmt[] = "%s %d%c";
@@ -58,13 +258,53 @@ void test_printf() {
   gfx.draw();
 }
 
+/// Test the asynchronous transfer, the task can run while the data is sent
+void test_async_transfer() {
+  static uint8_t buff[128 * 8]{};
+  TEST_ASSERT_TRUE(i2c.write_register_start(0x3C << 1, 0x40, buff, sizeof(buff)));
+  const uint32_t start = HAL_GetTick();
+  TEST_ASSERT_TRUE(i2c.wait_transfer(0x3C << 1));
+  // the tick interrupt isn't masked during the transfer
+  TEST_ASSERT_NOT_EQUAL(start, HAL_GetTick());
+  // the result is kept, until the next transfer
+  TEST_ASSERT_TRUE(i2c.wait_transfer(0x3C << 1));
+}
+
+/// Test filling the RAM, it waits for a running transfer, and takes about one frame
+void test_ram_fill() {
+  static uint8_t buff[128 * 8]{};
+  TEST_ASSERT_TRUE(i2c.write_register_start(0x3C << 1, 0x40, buff, sizeof(buff)));
+  uint32_t start = HAL_GetTick();
+  TEST_ASSERT_TRUE(display.set_ram_val(0xFF));
+  TEST_ASSERT_LESS_THAN(100, HAL_GetTick() - start);
+
+  start = HAL_GetTick();
+  TEST_ASSERT_TRUE(display.fill_checkerboard(8));
+  TEST_ASSERT_LESS_THAN(50, HAL_GetTick() - start);
+  TEST_ASSERT_TRUE(display.set_ram_val(0));
+  gfx.invalidate();
+}
+
 void test_task(void*) {
   UNITY_BEGIN();
 
   RUN_TEST(test_set_pixel);
   RUN_TEST(test_draw_rectangle);
+  RUN_TEST(test_draw_circle);
+  RUN_TEST(test_draw_line);
+  RUN_TEST(test_blit);
+  RUN_TEST(test_viewport_clip);
+  RUN_TEST(test_draw_image);
   RUN_TEST(test_draw_text);
+  RUN_TEST(test_draw_char_unaligned);
+  RUN_TEST(test_draw_large_digits);
+  RUN_TEST(test_text_layout);
+  RUN_TEST(test_widget_redraw);
+  RUN_TEST(test_cells_redraw);
+  RUN_TEST(test_draw_utf8);
   RUN_TEST(test_printf);
+  RUN_TEST(test_async_transfer);
+  RUN_TEST(test_ram_fill);
 
   UNITY_END();
 
@@ -78,3 +318,24 @@ void pre_test() {
   display.begin();
   gfx.clear_canvas();
 }
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void DMA1_Channel2_IRQHandler(void) {
+  HAL_DMA_IRQHandler(&i2c.hdmatx_);
+}
+
+void I2C1_EV_IRQHandler(void) {
+  HAL_I2C_EV_IRQHandler(&i2c.hi2c_);
+}
+
+void I2C1_ER_IRQHandler(void) {
+  HAL_I2C_ER_IRQHandler(&i2c.hi2c_);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -86,6 +86,45 @@ void test_multiple_commands() {
   TEST_ASSERT_EQUAL(39, dst);
 }
 
+void test_separator() {
+  feed_parser(parser, "A1 H10; A2 N0\n");
+  TEST_ASSERT_TRUE(parser.ended_with_separator());
+  TEST_ASSERT_EQUAL(1, parser.get_code());
+
+  feed_parser(parser, " A2 N0\n");
+  TEST_ASSERT_FALSE(parser.ended_with_separator());
+  TEST_ASSERT_EQUAL(2, parser.get_code());
+}
+
+void test_quoted_string() {
+  feed_parser(parser, "M1 \"x;A5\" \"B7\" A3\n");
+  TEST_ASSERT_FALSE(parser.ended_with_separator());
+
+  const char* str{ nullptr };
+  size_t len{ 0 };
+  TEST_ASSERT_TRUE(parser.get_string(1, str, len));
+  TEST_ASSERT_EQUAL(2, len);
+  TEST_ASSERT_EQUAL_STRING_LEN("B7", str, len);
+  TEST_ASSERT_FALSE(parser.get_string(2, str, len));
+
+  // parameters inside strings are ignored
+  int16_t dst{ 0 };
+  TEST_ASSERT_TRUE(parser.get_parameter('A', dst));
+  TEST_ASSERT_EQUAL(3, dst);
+}
+
+void test_overflow() {
+  // 64 characters don't fit, the command is reported when it ends, but isn't valid
+  feed_parser(parser, "A1 HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH;");
+  TEST_ASSERT_TRUE(parser.is_overflow());
+  TEST_ASSERT_FALSE(parser.is_valid());
+  TEST_ASSERT_TRUE(parser.ended_with_separator());
+
+  feed_parser(parser, "A2\n");
+  TEST_ASSERT_FALSE(parser.is_overflow());
+  TEST_ASSERT_EQUAL(2, parser.get_code());
+}
+
 
 void test_task(void*) {
   UNITY_BEGIN();
@@ -97,6 +136,9 @@ void test_task(void*) {
   RUN_TEST(test_default_param);
   RUN_TEST(test_get_param);
   RUN_TEST(test_multiple_commands);
+  RUN_TEST(test_separator);
+  RUN_TEST(test_quoted_string);
+  RUN_TEST(test_overflow);
 
   UNITY_END();
   while (1) {
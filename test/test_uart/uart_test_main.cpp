@@ -17,6 +17,7 @@ void test_task(void*) {
   RUN_TEST(test_send_data);
   RUN_TEST(test_printf);
   RUN_TEST(test_printf_overflow);
+  RUN_TEST(test_json_writer);
 
   UNITY_END();
 
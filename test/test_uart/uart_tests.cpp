@@ -2,6 +2,7 @@
  * @file uart_tests.cpp
  */
 #include "uart_tests.h"
+#include "json_writer.h"
 #include "nanoprintf.h"
 #include <unity.h>
 
@@ -132,4 +133,21 @@ void test_printf_overflow() {
 }
 
 
+void test_json_writer() {
+  const char expected[] = "{\"cmd\":\"A0\",\"n\":-1234,\"o\":{\"en\":true,\"s\":\"a\\\"b\"}}\n";
+  {
+    JsonWriter json(uart1);
+    json.add("cmd", "A0").add("n", -1234).begin_object("o").add_bool("en", true).add("s", "a\"b").end_object();
+  }
+  vTaskDelay(pdMS_TO_TICKS(200));
+
+  char result[60]{};
+  for (int i = 0; i < 59 && uart1.available(); ++i) {
+    result[i] = uart1.get_one();
+  }
+
+  TEST_ASSERT_EQUAL_STRING(expected, result);
+}
+
+
 UART_DMA uart1(UART_DMA::uart1_hw_init, UART_DMA::uart1_enable_isrs);
@@ -12,5 +12,6 @@ void test_transmit_data();
 void test_send_data();
 void test_printf();
 void test_printf_overflow();
+void test_json_writer();
 
 extern UART_DMA uart1;